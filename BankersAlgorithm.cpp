@@ -1,50 +1,266 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
 #include <vector>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
 using namespace std;
 
+// Ints per 64-byte cache line; every matrix row is padded to a multiple of this
+const int CACHE_LINE_INTS = 16;
+
+// Zero-initialised int array that starts on a cache line boundary
+class AlignedBuffer {
+private:
+    int* data;
+
+public:
+    AlignedBuffer(size_t count) {
+        size_t bytes = (count * sizeof(int) + 63) / 64 * 64;
+        data = static_cast<int*>(aligned_alloc(64, bytes ? bytes : 64));
+        if (!data) {
+            throw bad_alloc();
+        }
+        memset(data, 0, bytes);
+    }
+    ~AlignedBuffer() { free(data); }
+    AlignedBuffer(const AlignedBuffer&) = delete;
+    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+    int* get() { return data; }
+    const int* get() const { return data; }
+};
+
+// True if need[k] <= work[k] for every k. count is a multiple of CACHE_LINE_INTS and both
+// pointers are 64-byte aligned; padding columns are zero, so they always pass.
+inline bool fitsWithin(const int* need, const int* work, int count) {
+#if defined(__AVX2__)
+    for (int k = 0; k < count; k += 8) {
+        __m256i exceeded = _mm256_cmpgt_epi32(_mm256_load_si256((const __m256i*)(need + k)),
+                                              _mm256_load_si256((const __m256i*)(work + k)));
+        if (!_mm256_testz_si256(exceeded, exceeded)) {
+            return false;
+        }
+    }
+    return true;
+#elif defined(__SSE2__)
+    for (int k = 0; k < count; k += 4) {
+        __m128i exceeded = _mm_cmpgt_epi32(_mm_load_si128((const __m128i*)(need + k)),
+                                           _mm_load_si128((const __m128i*)(work + k)));
+        if (_mm_movemask_epi8(exceeded)) {
+            return false;
+        }
+    }
+    return true;
+#else
+    for (int k = 0; k < count; k++) {
+        if (need[k] > work[k]) {
+            return false;
+        }
+    }
+    return true;
+#endif
+}
+
+// work[k] += row[k], with the same layout requirements as fitsWithin
+inline void addRow(int* work, const int* row, int count) {
+#if defined(__AVX2__)
+    for (int k = 0; k < count; k += 8) {
+        __m256i sum = _mm256_add_epi32(_mm256_load_si256((const __m256i*)(work + k)),
+                                       _mm256_load_si256((const __m256i*)(row + k)));
+        _mm256_store_si256((__m256i*)(work + k), sum);
+    }
+#elif defined(__SSE2__)
+    for (int k = 0; k < count; k += 4) {
+        __m128i sum = _mm_add_epi32(_mm_load_si128((const __m128i*)(work + k)),
+                                    _mm_load_si128((const __m128i*)(row + k)));
+        _mm_store_si128((__m128i*)(work + k), sum);
+    }
+#else
+    for (int k = 0; k < count; k++) {
+        work[k] += row[k];
+    }
+#endif
+}
+
 class BankersAlgorithm {
 private:
-    vector<vector<int>> max;
-    vector<vector<int>> alloc;
-    vector<int> avail;
     int numProcesses;
     int numResources;
+    int stride;  // numResources rounded up to a whole number of cache lines
 
-public:
-    BankersAlgorithm(int np, int nr, vector<vector<int>> m, vector<vector<int>> a, vector<int> av) 
-        : numProcesses(np), numResources(nr), max(m), alloc(a), avail(av) {}
+    // Row-major matrices: row i starts at i * stride
+    AlignedBuffer max;
+    AlignedBuffer alloc;
+    AlignedBuffer need;
+    AlignedBuffer avail;
+    mutable AlignedBuffer work;  // Scratch copy of avail for the safety algorithm
+    // Per resource: (need, process) sorted by need. Built on the first safety check, then kept
+    // sorted as need cells change, so later checks never re-sort
+    mutable vector<vector<pair<int, int>>> columns;
+    mutable bool columnsBuilt;
+    int threads;
 
-    // Function to check if a process can request resources
-    bool isSafe(int process) {
-        vector<int> need(numResources);
-        // Calculate need matrix
-        for (int i = 0; i < numResources; i++) {
-            need[i] = max[process][i] - alloc[process][i];
+    // Undo log of every cell changed while a snapshot is open: taking a snapshot is O(1)
+    // and rolling back only touches the cells a tentative request actually changed
+    struct UndoEntry {
+        int* cell;
+        int oldValue;
+    };
+    vector<UndoEntry> undoLog;
+    int openSnapshots;
+
+    int* row(AlignedBuffer& matrix, int process) { return matrix.get() + (size_t)process * stride; }
+    const int* row(const AlignedBuffer& matrix, int process) const { return matrix.get() + (size_t)process * stride; }
+
+    void setCell(int& cell, int value) {
+        if (openSnapshots > 0) {
+            undoLog.push_back({&cell, cell});
         }
-        // Check if the process can safely request resources
-        for (int i = 0; i < numResources; i++) {
-            if (need[i] > avail[i]) {
-                return false;
+        cell = value;
+    }
+
+    // Moves the process's entry in column j from oldNeed to newNeed, shifting only the entries between
+    void moveInColumn(int j, int process, int oldNeed, int newNeed) {
+        if (!columnsBuilt || oldNeed == newNeed) {
+            return;
+        }
+        vector<pair<int, int>>& column = columns[j];
+        auto from = lower_bound(column.begin(), column.end(), make_pair(oldNeed, process));
+        auto to = lower_bound(column.begin(), column.end(), make_pair(newNeed, process));
+        if (to > from) {
+            rotate(from, from + 1, to);
+            *(to - 1) = {newNeed, process};
+        } else {
+            rotate(to, from, from + 1);
+            *to = {newNeed, process};
+        }
+    }
+
+    void setNeed(int process, int j, int value) {
+        int& cell = row(need, process)[j];
+        moveInColumn(j, process, cell, value);
+        setCell(cell, value);
+    }
+
+    void validate(int process, const vector<int>& amounts) const {
+        if (process < 0 || process >= numProcesses || (int)amounts.size() != numResources) {
+            throw invalid_argument("Invalid process or resource vector");
+        }
+        for (int amount : amounts) {
+            if (amount < 0) {
+                throw invalid_argument("Resource amounts must be non-negative");
             }
         }
-        return true;
     }
 
-    // Banker's algorithm implementation
-    bool execute() {
+    // Builds, for every resource, the processes sorted by their need of it. Columns are
+    // independent, so wide matrices are split into column ranges across threads.
+    void sortColumns() const {
+        columnsBuilt = true;
+        columns.resize(numResources);
+        auto build = [this](int first, int last) {
+            for (int j = first; j < last; j++) {
+                columns[j].resize(numProcesses);
+            }
+            for (int i = 0; i < numProcesses; i++) {
+                const int* n = row(need, i);
+                for (int j = first; j < last; j++) {
+                    columns[j][i] = {n[j], i};
+                }
+            }
+            for (int j = first; j < last; j++) {
+                sort(columns[j].begin(), columns[j].end());
+            }
+        };
+
+        int workers = std::min(threads, numResources);
+        if (workers <= 1 || (long long)numProcesses * numResources < (1 << 16)) {
+            build(0, numResources);
+            return;
+        }
+        vector<thread> pool;
+        for (int t = 0; t < workers; t++) {
+            pool.emplace_back(build, numResources * t / workers, numResources * (t + 1) / workers);
+        }
+        for (auto& worker : pool) {
+            worker.join();
+        }
+    }
+
+    // Safety algorithm in O(n * m * log n) on a scratch copy of avail, so the live state is left
+    // untouched. Each resource keeps a cursor into its sorted column past every process whose need
+    // fits in work; when work grows only those cursors move, and a process becomes runnable once
+    // all m cursors have passed it, so no process is rescanned.
+    bool findSafeSequence(vector<int>& safeSequence) const {
+        int* w = work.get();
+        memcpy(w, avail.get(), stride * sizeof(int));
+        if (!columnsBuilt) {
+            sortColumns();
+        }
+        vector<int> cursor(numResources, 0);
+        vector<int> satisfied(numProcesses, 0);
+        safeSequence.clear();
+
+        auto advance = [&](int j) {
+            const vector<pair<int, int>>& column = columns[j];
+            int& c = cursor[j];
+            while (c < numProcesses && column[c].first <= w[j]) {
+                if (++satisfied[column[c].second] == numResources) {
+                    safeSequence.push_back(column[c].second);
+                }
+                c++;
+            }
+        };
+
+        if (numResources == 0) {
+            for (int i = 0; i < numProcesses; i++) {
+                safeSequence.push_back(i);
+            }
+        }
+        for (int j = 0; j < numResources; j++) {
+            advance(j);
+        }
+        // safeSequence doubles as the FIFO of runnable processes
+        for (size_t next = 0; next < safeSequence.size(); next++) {
+            const int* a = row(alloc, safeSequence[next]);
+            addRow(w, a, stride);
+            for (int j = 0; j < numResources; j++) {
+                if (a[j] > 0) {
+                    advance(j);
+                }
+            }
+        }
+        return (int)safeSequence.size() == numProcesses;
+    }
+
+    // Original safety algorithm: rescans every unfinished process on each pass, O(n^2 * m).
+    // Returns 1 if safe, 0 if unsafe and -1 if maxPasses ran out before it could tell.
+    int scanPasses(vector<int>& safeSequence, int maxPasses) const {
+        int* w = work.get();
+        memcpy(w, avail.get(), stride * sizeof(int));
         vector<bool> finish(numProcesses, false);
-        vector<int> safeSequence;
         int numFinished = 0;
-        
-        while (numFinished < numProcesses) {
+        safeSequence.clear();
+
+        for (int pass = 0; numFinished < numProcesses; pass++) {
+            if (pass == maxPasses) {
+                return -1;
+            }
             bool found = false;
             // Try to find an unfinished process that can request resources
             for (int i = 0; i < numProcesses; i++) {
-                if (!finish[i] && isSafe(i)) {
+                if (!finish[i] && fitsWithin(row(need, i), w, stride)) {
                     // Grant resources to the process
-                    for (int j = 0; j < numResources; j++) {
-                        avail[j] += alloc[i][j];
-                    }
+                    addRow(w, row(alloc, i), stride);
                     safeSequence.push_back(i);
                     finish[i] = true;
                     numFinished++;
@@ -53,13 +269,172 @@ public:
             }
             // If no such process is found, the system is in an unsafe state
             if (!found) {
-                return false;
+                return 0;
+            }
+        }
+        return 1;
+    }
+
+    bool findSafeSequenceByScan(vector<int>& safeSequence) const {
+        return scanPasses(safeSequence, numProcesses + 1) == 1;
+    }
+
+    // Check used on the request path: after a single small request a couple of SIMD scan passes
+    // usually finish every process, so those run first and the sorted cursors are only used when
+    // the scan has not decided by then
+    bool findSafeSequenceForRequest(vector<int>& safeSequence) const {
+        const int SCAN_PASSES = 2;
+        int result = scanPasses(safeSequence, SCAN_PASSES);
+        return result < 0 ? findSafeSequence(safeSequence) : result == 1;
+    }
+
+    // A mark is only valid while its snapshot is open: rolling back or committing twice, or past the
+    // end of the log, would otherwise drive openSnapshots negative and keep the log forever
+    void checkSnapshot(size_t mark) const {
+        if (openSnapshots == 0 || mark > undoLog.size()) {
+            throw logic_error("No open snapshot for this mark");
+        }
+    }
+
+public:
+    BankersAlgorithm(int np, int nr, const vector<vector<int>>& m, const vector<vector<int>>& a, const vector<int>& av)
+        : numProcesses(np), numResources(nr),
+          stride((nr + CACHE_LINE_INTS - 1) / CACHE_LINE_INTS * CACHE_LINE_INTS),
+          max((size_t)np * stride), alloc((size_t)np * stride), need((size_t)np * stride),
+          avail(stride), work(stride), columnsBuilt(false), threads(std::max(1u, thread::hardware_concurrency())), openSnapshots(0) {
+        if (np < 0 || nr < 0 || (int)m.size() != np || (int)a.size() != np || (int)av.size() != nr) {
+            throw invalid_argument("Matrix dimensions do not match the process and resource counts");
+        }
+        for (int i = 0; i < numProcesses; i++) {
+            if ((int)m[i].size() != nr || (int)a[i].size() != nr) {
+                throw invalid_argument("Matrix dimensions do not match the process and resource counts");
+            }
+            for (int j = 0; j < numResources; j++) {
+                row(max, i)[j] = m[i][j];
+                row(alloc, i)[j] = a[i][j];
+                row(need, i)[j] = m[i][j] - a[i][j];
             }
         }
+        memcpy(avail.get(), av.data(), nr * sizeof(int));
+    }
+
+    // Function to check if a process can request resources
+    bool isSafe(int process) {
+        return fitsWithin(row(need, process), avail.get(), stride);
+    }
+
+    // Threads used to sort the per-resource columns of the safety check; the columns are rebuilt
+    // with that many threads on the next check
+    void setThreads(int count) {
+        threads = count > 0 ? count : 1;
+        columnsBuilt = false;
+    }
+
+    bool isSafeState() const {
+        vector<int> safeSequence;
+        return findSafeSequence(safeSequence);
+    }
+
+    bool isSafeStateByScan() const {
+        vector<int> safeSequence;
+        return findSafeSequenceByScan(safeSequence);
+    }
+
+    // Opens a snapshot of the current state; pass the returned mark to rollback() or commit()
+    size_t snapshot() {
+        openSnapshots++;
+        return undoLog.size();
+    }
+
+    void rollback(size_t mark) {
+        checkSnapshot(mark);
+        const int* needBegin = need.get();
+        const int* needEnd = needBegin + (size_t)numProcesses * stride;
+        while (undoLog.size() > mark) {
+            int* cell = undoLog.back().cell;
+            int oldValue = undoLog.back().oldValue;
+            if (cell >= needBegin && cell < needEnd) {
+                size_t offset = cell - needBegin;
+                moveInColumn(offset % stride, offset / stride, *cell, oldValue);
+            }
+            *cell = oldValue;
+            undoLog.pop_back();
+        }
+        commit(mark);
+    }
+
+    // Keeps the changes made since the snapshot; the log is dropped once no snapshot is open
+    void commit(size_t mark) {
+        checkSnapshot(mark);
+        if (--openSnapshots == 0) {
+            undoLog.clear();
+        }
+    }
+
+    // Resource-request algorithm: grants the request only if the resulting state is safe.
+    // Returns false (and leaves the state unchanged) if the process has to wait.
+    bool requestResources(int process, const vector<int>& request) {
+        validate(process, request);
+        int* a = row(alloc, process);
+        int* n = row(need, process);
+        int* av = avail.get();
+        // Every column is checked against the maximum claim before any against avail, so an
+        // invalid request is rejected even when an earlier column would only have to wait
+        for (int j = 0; j < numResources; j++) {
+            if (request[j] > n[j]) {
+                throw invalid_argument("Process has exceeded its maximum claim");
+            }
+        }
+        for (int j = 0; j < numResources; j++) {
+            if (request[j] > av[j]) {
+                return false;  // Not enough resources available right now
+            }
+        }
+
+        // Pretend to allocate, then keep the allocation only if the system stays safe
+        size_t mark = snapshot();
+        for (int j = 0; j < numResources; j++) {
+            setCell(av[j], av[j] - request[j]);
+            setCell(a[j], a[j] + request[j]);
+            setNeed(process, j, n[j] - request[j]);
+        }
+
+        vector<int> safeSequence;
+        if (!findSafeSequenceForRequest(safeSequence)) {
+            rollback(mark);
+            return false;
+        }
+        commit(mark);
+        return true;
+    }
+
+    void releaseResources(int process, const vector<int>& release) {
+        validate(process, release);
+        int* a = row(alloc, process);
+        int* n = row(need, process);
+        int* av = avail.get();
+        for (int j = 0; j < numResources; j++) {
+            if (release[j] > a[j]) {
+                throw invalid_argument("Process cannot release more than it holds");
+            }
+        }
+        for (int j = 0; j < numResources; j++) {
+            setCell(a[j], a[j] - release[j]);
+            setNeed(process, j, n[j] + release[j]);
+            setCell(av[j], av[j] + release[j]);
+        }
+    }
+
+    // Banker's algorithm implementation
+    bool execute() {
+        vector<int> safeSequence;
+        if (!findSafeSequence(safeSequence)) {
+            return false;
+        }
 
         // If all processes have been granted resources safely
         cout << "Safe sequence: ";
-        for (int i = 0; i < safeSequence.size(); i++) {
+        for (size_t i = 0; i < safeSequence.size(); i++) {
             cout << "P" << safeSequence[i];
             if (i < safeSequence.size() - 1) {
                 cout << " -> ";
@@ -70,34 +445,131 @@ public:
     }
 };
 
-int main() {
-    int numProcesses = 5, numResources = 3;
-    
-    vector<vector<int>> max = {
-        {7, 5, 3},
-        {3, 2, 2},
-        {9, 0, 2},
-        {2, 2, 2},
-        {4, 3, 3}
-    };
-    
-    vector<vector<int>> alloc = {
-        {0, 1, 0},
-        {2, 0, 0},
-        {3, 0, 2},
-        {2, 1, 1},
-        {0, 0, 2}
-    };
-    
-    vector<int> avail = {3, 3, 2};
+// Worst case for the scanning check: only the last unfinished process can ever run, so every
+// pass over the processes finishes exactly one of them
+void runBenchmark() {
+    const int numResources = 64;
+    cout << "Processes\tScan (s)\tSorted (s)\tSorted, " << std::max(1u, thread::hardware_concurrency()) << " threads (s)" << endl;
+    for (int numProcesses = 1000; numProcesses <= 100000; numProcesses *= 10) {
+        vector<vector<int>> max(numProcesses, vector<int>(numResources));
+        vector<vector<int>> alloc(numProcesses, vector<int>(numResources, 1));
+        vector<int> avail(numResources, 1);
+        for (int i = 0; i < numProcesses; i++) {
+            for (int j = 0; j < numResources; j++) {
+                max[i][j] = numProcesses - i + 1;
+            }
+        }
+        BankersAlgorithm banker(numProcesses, numResources, max, alloc, avail);
+
+        auto time = [](auto check) {
+            auto start = chrono::steady_clock::now();
+            if (!check()) {
+                throw runtime_error("Benchmark state should be safe");
+            }
+            return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        };
+        // The scan takes about a minute at 100000 processes, so it is only timed below that
+        double scan = numProcesses < 100000 ? time([&] { return banker.isSafeStateByScan(); }) : -1;
+        banker.setThreads(1);
+        double sorted = time([&] { return banker.isSafeState(); });
+        banker.setThreads(thread::hardware_concurrency());
+        double parallel = time([&] { return banker.isSafeState(); });
+        cout << numProcesses << "\t\t" << (scan < 0 ? string("-") : to_string(scan)) << "\t" << sorted << "\t" << parallel << endl;
+    }
+}
 
-    BankersAlgorithm banker(numProcesses, numResources, max, alloc, avail);
-    
-    if (banker.execute()) {
-        cout << "System is in a safe state." << endl;
-    } else {
-        cout << "System is in an unsafe state." << endl;
+// Admission path: each step grants a small request against one live state and releases it again.
+// The request path (SIMD scan first, incrementally sorted columns as fallback) is timed next to a
+// full safety check that re-sorts every column, which is what each request used to run.
+void runRequestBenchmark() {
+    const int numResources = 64;
+    const int steps = 20000;
+    cout << "\nProcesses\tRe-sorting check (req/s)\tRequest path (req/s)" << endl;
+    for (int numProcesses = 1000; numProcesses <= 100000; numProcesses *= 10) {
+        vector<vector<int>> max(numProcesses, vector<int>(numResources, 10));
+        vector<vector<int>> alloc(numProcesses, vector<int>(numResources, 0));
+        vector<int> avail(numResources, 10);
+        BankersAlgorithm banker(numProcesses, numResources, max, alloc, avail);
+
+        auto rate = [&](bool resort, int count) {
+            unsigned seed = 1;
+            auto start = chrono::steady_clock::now();
+            for (int step = 0; step < count; step++) {
+                seed = seed * 1103515245 + 12345;
+                int process = (seed >> 8) % numProcesses;
+                vector<int> request(numResources, 0);
+                for (int k = 0; k < 4; k++) {
+                    request[(seed >> (k * 6)) % numResources] = 1;
+                }
+                if (resort) {
+                    banker.setThreads(1);  // Drops the sorted columns
+                    if (!banker.isSafeState()) {
+                        throw runtime_error("Benchmark state should be safe");
+                    }
+                } else if (!banker.requestResources(process, request)) {
+                    throw runtime_error("Benchmark request should be granted");
+                } else {
+                    banker.releaseResources(process, request);
+                }
+            }
+            return count / chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        };
+        // Re-sorting takes about a tenth of a second per check at 100000 processes, so it runs fewer times
+        double resorted = rate(true, std::max(5, 20000000 / (numProcesses * numResources)));
+        double requestPath = rate(false, steps);
+        cout << numProcesses << "\t\t" << resorted << "\t\t\t" << requestPath << endl;
     }
-    
+}
+
+// Usage: BankersAlgorithm [--bench]
+int main(int argc, char* argv[]) {
+    try {
+        if (argc > 1 && string(argv[1]) == "--bench") {
+            runBenchmark();
+            runRequestBenchmark();
+            return 0;
+        }
+
+        int numProcesses = 5, numResources = 3;
+
+        vector<vector<int>> max = {
+            {7, 5, 3},
+            {3, 2, 2},
+            {9, 0, 2},
+            {2, 2, 2},
+            {4, 3, 3}
+        };
+
+        vector<vector<int>> alloc = {
+            {0, 1, 0},
+            {2, 0, 0},
+            {3, 0, 2},
+            {2, 1, 1},
+            {0, 0, 2}
+        };
+
+        vector<int> avail = {3, 3, 2};
+
+        BankersAlgorithm banker(numProcesses, numResources, max, alloc, avail);
+
+        if (banker.execute()) {
+            cout << "System is in a safe state." << endl;
+        } else {
+            cout << "System is in an unsafe state." << endl;
+        }
+
+        // Admission decisions against the same live state
+        cout << "P1 requests (1, 0, 2): " << (banker.requestResources(1, {1, 0, 2}) ? "granted" : "denied") << endl;
+        cout << "P4 requests (3, 3, 0): " << (banker.requestResources(4, {3, 3, 0}) ? "granted" : "denied") << endl;
+        cout << "P0 requests (0, 2, 0): " << (banker.requestResources(0, {0, 2, 0}) ? "granted" : "denied") << endl;
+        banker.releaseResources(1, {1, 0, 2});
+        cout << "P1 released (1, 0, 2)" << endl;
+        banker.execute();
+    }
+    catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+
     return 0;
 }
@@ -3,6 +3,18 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
 
 class Resource {
 private:
@@ -31,11 +43,262 @@ public:
     }
 };
 
+// Shared pool behind every ResourceVector: blocks of 2^k ints are carved from large chunks and
+// recycled through intrusive per-size free lists, so processes own no heap nodes of their own
+class ResourceArena {
+private:
+    static constexpr size_t CHUNK_INTS = 1 << 18;
+
+    std::mutex mutex;
+    std::vector<std::unique_ptr<int[]>> chunks;       // Small blocks are carved from these
+    std::vector<std::unique_ptr<int[]>> largeBlocks;  // Blocks too big to carve, one allocation each
+    int* currentChunk = nullptr;
+    size_t chunkUsed = CHUNK_INTS;
+    int* freeLists[32] = {};
+
+public:
+    static ResourceArena& shared() {
+        static ResourceArena arena;
+        return arena;
+    }
+
+    int* allocate(int sizeClass) {
+        size_t ints = size_t(1) << sizeClass;
+        std::lock_guard<std::mutex> lock(mutex);
+        if (int* block = freeLists[sizeClass]) {
+            std::memcpy(&freeLists[sizeClass], block, sizeof(int*));
+            return block;
+        }
+        if (ints > CHUNK_INTS / 4) {
+            largeBlocks.emplace_back(new int[ints]);
+            return largeBlocks.back().get();
+        }
+        if (chunkUsed + ints > CHUNK_INTS) {
+            chunks.emplace_back(new int[CHUNK_INTS]);
+            currentChunk = chunks.back().get();
+            chunkUsed = 0;
+        }
+        int* block = currentChunk + chunkUsed;
+        chunkUsed += ints;
+        return block;
+    }
+
+    void release(int* block, int sizeClass) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::memcpy(block, &freeLists[sizeClass], sizeof(int*));
+        freeLists[sizeClass] = block;
+    }
+};
+
+// Instances per resource id for one process. Processes touching a few resource types keep sorted
+// (id, instances) pairs; once the ids are dense enough it switches to a plain array indexed by
+// id - base. Either way the entries are contiguous, and zero entries are never stored or visited.
+class ResourceVector {
+private:
+    static constexpr int DENSE_MIN_ENTRIES = 8;
+
+    int* data = nullptr;
+    int count = 0;        // Non-zero entries
+    int base = 0;         // Dense: resource id of data[0]
+    int length = 0;       // Dense: ints in use
+    int8_t sizeClass = -1;
+    bool dense = false;
+
+    int capacity() const { return sizeClass < 0 ? 0 : 1 << sizeClass; }
+
+    void reallocate(int ints) {
+        int newClass = 1;
+        while ((1 << newClass) < ints) {
+            newClass++;
+        }
+        int* block = ResourceArena::shared().allocate(newClass);
+        if (data) {
+            std::memcpy(block, data, std::min(capacity(), 1 << newClass) * sizeof(int));
+            ResourceArena::shared().release(data, sizeClass);
+        }
+        data = block;
+        sizeClass = static_cast<int8_t>(newClass);
+    }
+
+    // Binary search over the sorted pairs; returns the position of id or where it belongs
+    int find(int id) const {
+        int low = 0, high = count;
+        while (low < high) {
+            int mid = (low + high) / 2;
+            if (data[2 * mid] < id) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        return low;
+    }
+
+    void toDense(int first, int last) {
+        std::vector<int> entries(data, data + 2 * count);
+        length = last - first + 1;
+        if (length > capacity()) {
+            reallocate(length);
+        }
+        std::fill(data, data + length, 0);
+        base = first;
+        for (int k = 0; k < count; ++k) {
+            data[entries[2 * k] - base] = entries[2 * k + 1];
+        }
+        dense = true;
+    }
+
+    void toSparse() {
+        std::vector<int> entries;
+        for (int k = 0; k < length; ++k) {
+            if (data[k] != 0) {
+                entries.push_back(base + k);
+                entries.push_back(data[k]);
+            }
+        }
+        if (static_cast<int>(entries.size()) > capacity()) {
+            reallocate(static_cast<int>(entries.size()));
+        }
+        std::copy(entries.begin(), entries.end(), data);
+        dense = false;
+        length = 0;
+    }
+
+public:
+    ResourceVector() {}
+    ResourceVector(const ResourceVector& other)
+        : count(other.count), base(other.base), length(other.length), dense(other.dense) {
+        int used = dense ? length : 2 * count;
+        if (used > 0) {
+            reallocate(used);
+            std::memcpy(data, other.data, used * sizeof(int));
+        }
+    }
+    ResourceVector(ResourceVector&& other) noexcept { swap(other); }
+    ~ResourceVector() {
+        if (data) {
+            ResourceArena::shared().release(data, sizeClass);
+        }
+    }
+
+    ResourceVector& operator=(ResourceVector other) {
+        swap(other);
+        return *this;
+    }
+
+    void swap(ResourceVector& other) noexcept {
+        std::swap(data, other.data);
+        std::swap(count, other.count);
+        std::swap(base, other.base);
+        std::swap(length, other.length);
+        std::swap(sizeClass, other.sizeClass);
+        std::swap(dense, other.dense);
+    }
+
+    int get(int id) const {
+        if (dense) {
+            return id >= base && id < base + length ? data[id - base] : 0;
+        }
+        int k = find(id);
+        return k < count && data[2 * k] == id ? data[2 * k + 1] : 0;
+    }
+
+    void add(int id, int delta) {
+        if (delta == 0) {
+            return;
+        }
+        if (dense) {
+            if (id < base || id >= base + length) {
+                int first = std::min(id, base);
+                int last = std::max(id, base + length - 1);
+                if (last - first + 1 > 2 * (count + 1)) {
+                    toSparse();
+                    add(id, delta);
+                    return;
+                }
+                // Widen the array to cover id
+                std::vector<int> values(data, data + length);
+                if (last - first + 1 > capacity()) {
+                    reallocate(last - first + 1);
+                }
+                std::fill(data, data + (last - first + 1), 0);
+                std::copy(values.begin(), values.end(), data + (base - first));
+                base = first;
+                length = last - first + 1;
+            }
+            int& value = data[id - base];
+            count += (value == 0) - (value + delta == 0);
+            value += delta;
+            return;
+        }
+
+        int k = find(id);
+        if (k < count && data[2 * k] == id) {
+            if ((data[2 * k + 1] += delta) == 0) {
+                std::copy(data + 2 * (k + 1), data + 2 * count, data + 2 * k);
+                count--;
+            }
+            return;
+        }
+        if (2 * (count + 1) > capacity()) {
+            reallocate(2 * (count + 1));
+        }
+        std::copy_backward(data + 2 * k, data + 2 * count, data + 2 * (count + 1));
+        data[2 * k] = id;
+        data[2 * k + 1] = delta;
+        count++;
+
+        int span = data[2 * (count - 1)] - data[0] + 1;
+        if (count >= DENSE_MIN_ENTRIES && span <= 2 * count) {
+            toDense(data[0], data[2 * (count - 1)]);
+        }
+    }
+
+    size_t size() const { return count; }
+
+    // Bytes used by this vector, including its arena block
+    size_t memoryUsage() const { return sizeof(*this) + capacity() * sizeof(int); }
+
+    // Visits the non-zero entries in increasing resource id as (id, instances) pairs
+    class const_iterator {
+    private:
+        const ResourceVector* vector;
+        int position;
+
+        void skipZeros() {
+            while (vector->dense && position < vector->length && vector->data[position] == 0) {
+                position++;
+            }
+        }
+
+    public:
+        const_iterator(const ResourceVector* v, int p) : vector(v), position(p) { skipZeros(); }
+
+        std::pair<int, int> operator*() const {
+            if (vector->dense) {
+                return {vector->base + position, vector->data[position]};
+            }
+            return {vector->data[2 * position], vector->data[2 * position + 1]};
+        }
+
+        const_iterator& operator++() {
+            position++;
+            skipZeros();
+            return *this;
+        }
+
+        bool operator!=(const const_iterator& other) const { return position != other.position; }
+    };
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, dense ? length : count); }
+};
+
 class Process {
 private:
     int id;
-    std::unordered_map<int, int> allocated_resources;
-    std::unordered_map<int, int> requested_resources;
+    ResourceVector allocated_resources;
+    ResourceVector requested_resources;
 
 public:
     Process(int processId) : id(processId) {}
@@ -43,87 +306,432 @@ public:
     int getId() const { return id; }
 
     void requestResource(int resourceId, int instances) {
-        requested_resources[resourceId] += instances;
+        requested_resources.add(resourceId, instances);
     }
 
     void allocateResource(int resourceId, int instances) {
-        allocated_resources[resourceId] += instances;
-        requested_resources[resourceId] -= instances;
+        allocated_resources.add(resourceId, instances);
+        requested_resources.add(resourceId, -instances);
     }
 
     void releaseResource(int resourceId, int instances) {
-        if (allocated_resources[resourceId] >= instances) {
-            allocated_resources[resourceId] -= instances;
+        if (allocated_resources.get(resourceId) >= instances) {
+            allocated_resources.add(resourceId, -instances);
         }
     }
 
-    const std::unordered_map<int, int>& getAllocatedResources() const { 
+    const ResourceVector& getAllocatedResources() const { 
         return allocated_resources; 
     }
 
-    const std::unordered_map<int, int>& getRequestedResources() const { 
+    const ResourceVector& getRequestedResources() const { 
         return requested_resources; 
     }
+
+    size_t memoryUsage() const {
+        return sizeof(id) + allocated_resources.memoryUsage() + requested_resources.memoryUsage();
+    }
 };
 
-class DeadlockDetector {
+// Wait-for graph in compressed sparse row form: vertex v waits on targets[offsets[v]] up to
+// targets[offsets[v + 1] - 1]. Vertices are dense indices and ids maps them back to process ids.
+class WaitForGraph {
 private:
-    std::vector<Resource> resources;
-    std::vector<Process> processes;
+    std::vector<int> ids;
+    std::vector<size_t> offsets;
+    std::vector<int> targets;
+
+public:
+    // Edges are (waiting vertex, vertex waited on) pairs over the vertices 0 .. vertexIds.size() - 1
+    WaitForGraph(std::vector<int> vertexIds, const std::vector<std::pair<int, int>>& edges)
+        : ids(std::move(vertexIds)), offsets(ids.size() + 1, 0), targets(edges.size()) {
+        int n = static_cast<int>(ids.size());
+        for (const auto& [from, to] : edges) {
+            if (from < 0 || from >= n || to < 0 || to >= n) {
+                throw std::invalid_argument("Wait-for edge refers to an unknown vertex");
+            }
+            offsets[from + 1]++;
+        }
+        for (int v = 0; v < n; ++v) {
+            offsets[v + 1] += offsets[v];
+        }
+        std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+        for (const auto& [from, to] : edges) {
+            targets[next[from]++] = to;
+        }
+    }
 
-    bool hasCycle(std::unordered_map<int, std::unordered_set<int>>& graph) {
-        std::unordered_set<int> visited;
-        std::unordered_set<int> rec_stack;
+    // Builds the graph from process-id adjacency sets; every process and every id in the sets gets a vertex
+    static WaitForGraph fromAdjacency(const std::unordered_map<int, std::unordered_set<int>>& graph,
+                                      const std::vector<Process>& processes) {
+        std::unordered_map<int, int> vertexOf;
+        std::vector<int> vertexIds;
+        auto vertex = [&](int processId) {
+            auto [it, inserted] = vertexOf.emplace(processId, static_cast<int>(vertexIds.size()));
+            if (inserted) {
+                vertexIds.push_back(processId);
+            }
+            return it->second;
+        };
 
         for (const auto& process : processes) {
-            if (detectCycleDFS(process.getId(), graph, visited, rec_stack)) {
-                return true;
+            vertex(process.getId());
+        }
+        std::vector<std::pair<int, int>> edges;
+        for (const auto& [from, waitsOn] : graph) {
+            int v = vertex(from);
+            for (int to : waitsOn) {
+                edges.push_back({v, vertex(to)});
             }
         }
-        return false;
+        return WaitForGraph(std::move(vertexIds), edges);
     }
 
-    bool detectCycleDFS(int processId, 
-                        std::unordered_map<int, std::unordered_set<int>>& graph, 
-                        std::unordered_set<int>& visited, 
-                        std::unordered_set<int>& rec_stack) {
-        if (rec_stack.find(processId) != rec_stack.end()) {
-            return true;
+    size_t vertexCount() const { return ids.size(); }
+    size_t edgeCount() const { return targets.size(); }
+
+    // Iterative Tarjan SCC pass, O(V + E) with an explicit stack so long wait chains cannot overflow
+    // the call stack. Every strongly connected component with a cycle (more than one process, or a
+    // process waiting on itself) is a set of deadlocked processes; each set is returned as process ids.
+    std::vector<std::vector<int>> deadlockedSets() const {
+        int n = static_cast<int>(ids.size());
+        std::vector<int> index(n, -1);
+        std::vector<int> lowLink(n, 0);
+        std::vector<char> onStack(n, 0);
+        std::vector<int> componentStack;
+        std::vector<std::pair<int, size_t>> callStack;  // (vertex, next edge to explore)
+        std::vector<std::vector<int>> deadlocked;
+        int nextIndex = 0;
+
+        for (int root = 0; root < n; ++root) {
+            if (index[root] != -1) {
+                continue;
+            }
+            callStack.push_back({root, offsets[root]});
+            index[root] = lowLink[root] = nextIndex++;
+            componentStack.push_back(root);
+            onStack[root] = 1;
+
+            while (!callStack.empty()) {
+                auto& [v, edge] = callStack.back();
+                if (edge < offsets[v + 1]) {
+                    int w = targets[edge++];
+                    if (index[w] == -1) {
+                        index[w] = lowLink[w] = nextIndex++;
+                        componentStack.push_back(w);
+                        onStack[w] = 1;
+                        callStack.push_back({w, offsets[w]});
+                    } else if (onStack[w]) {
+                        lowLink[v] = std::min(lowLink[v], index[w]);
+                    }
+                    continue;
+                }
+
+                // All edges of v explored: pop it and report its component if v is the root
+                int finished = v;
+                callStack.pop_back();
+                if (!callStack.empty()) {
+                    int parent = callStack.back().first;
+                    lowLink[parent] = std::min(lowLink[parent], lowLink[finished]);
+                }
+                if (lowLink[finished] != index[finished]) {
+                    continue;
+                }
+
+                std::vector<int> component;
+                int w;
+                do {
+                    w = componentStack.back();
+                    componentStack.pop_back();
+                    onStack[w] = 0;
+                    component.push_back(ids[w]);
+                } while (w != finished);
+
+                bool waitsOnItself = component.size() == 1 &&
+                    std::find(targets.begin() + offsets[finished], targets.begin() + offsets[finished + 1], finished)
+                        != targets.begin() + offsets[finished + 1];
+                if (component.size() > 1 || waitsOnItself) {
+                    std::sort(component.begin(), component.end());
+                    deadlocked.push_back(std::move(component));
+                }
+            }
         }
+        return deadlocked;
+    }
+};
+
+// Wait-for graph that is updated one edge at a time and never allowed to contain a cycle. It keeps a
+// topological order of the processes (Pearce-Kelly): an edge that agrees with the order is added in
+// O(1); otherwise only the processes whose order lies between its endpoints are searched and
+// reordered, so the cost is proportional to the affected region rather than the whole graph.
+class DynamicWaitForGraph {
+private:
+    std::unordered_map<int, int> vertexOf;
+    std::vector<int> ids;
+    std::vector<std::vector<int>> waitsOn;    // Out-edges: processes this one waits for
+    std::vector<std::vector<int>> waitedBy;   // In-edges
+    std::vector<int> order;                   // Position of each vertex in the topological order
+    std::vector<int> vertexAt;                // Inverse of order
+    std::vector<char> visited;
+    std::vector<int> parent;
+    std::vector<int> lastCycle;
+
+    int vertex(int processId) {
+        auto [it, inserted] = vertexOf.emplace(processId, static_cast<int>(ids.size()));
+        if (inserted) {
+            ids.push_back(processId);
+            waitsOn.emplace_back();
+            waitedBy.emplace_back();
+            order.push_back(static_cast<int>(vertexAt.size()));
+            vertexAt.push_back(it->second);
+            visited.push_back(0);
+            parent.push_back(-1);
+        }
+        return it->second;
+    }
 
-        if (visited.find(processId) != visited.end()) {
+    static bool eraseOne(std::vector<int>& edges, int target) {
+        auto it = std::find(edges.begin(), edges.end(), target);
+        if (it == edges.end()) {
             return false;
         }
+        *it = edges.back();
+        edges.pop_back();
+        return true;
+    }
 
-        visited.insert(processId);
-        rec_stack.insert(processId);
+    // Vertices reachable from start whose order is below upperBound. Returns false, with the
+    // cycle recorded, if blocked is reachable. Every visited vertex ends up in reached.
+    bool searchForward(int start, int upperBound, int blocked, std::vector<int>& reached) {
+        std::vector<int> stack = {start};
+        visited[start] = 1;
+        parent[start] = -1;
+        reached.push_back(start);
+        while (!stack.empty()) {
+            int v = stack.back();
+            stack.pop_back();
+            for (int w : waitsOn[v]) {
+                if (w == blocked) {
+                    // Path start -> ... -> v -> blocked, closed by the new edge blocked -> start
+                    lastCycle.assign(1, ids[blocked]);
+                    std::vector<int> path;
+                    for (int u = v; u != -1; u = parent[u]) {
+                        path.push_back(ids[u]);
+                    }
+                    lastCycle.insert(lastCycle.end(), path.rbegin(), path.rend());
+                    return false;
+                }
+                if (!visited[w] && order[w] < upperBound) {
+                    visited[w] = 1;
+                    parent[w] = v;
+                    reached.push_back(w);
+                    stack.push_back(w);
+                }
+            }
+        }
+        return true;
+    }
 
-        for (int adjacentProcess : graph[processId]) {
-            if (detectCycleDFS(adjacentProcess, graph, visited, rec_stack)) {
-                return true;
+    // Vertices that reach start and whose order is above lowerBound
+    void searchBackward(int start, int lowerBound, std::vector<int>& reached) {
+        std::vector<int> stack = {start};
+        visited[start] = 1;
+        reached.push_back(start);
+        while (!stack.empty()) {
+            int v = stack.back();
+            stack.pop_back();
+            for (int w : waitedBy[v]) {
+                if (!visited[w] && order[w] > lowerBound) {
+                    visited[w] = 1;
+                    reached.push_back(w);
+                    stack.push_back(w);
+                }
             }
         }
+    }
 
-        rec_stack.erase(processId);
-        return false;
+public:
+    // Adds "from waits for to". Returns false and leaves the graph unchanged if the edge would close
+    // a cycle, i.e. the wait would deadlock; getLastCycle() then holds the processes on that cycle.
+    bool addEdge(int fromId, int toId) {
+        int from = vertex(fromId);
+        int to = vertex(toId);
+        if (from == to) {
+            lastCycle.assign(1, fromId);
+            return false;
+        }
+
+        if (order[to] < order[from]) {
+            int lowerBound = order[to];
+            int upperBound = order[from];
+            std::vector<int> forward, backward;
+            bool acyclic = searchForward(to, upperBound, from, forward);
+            if (acyclic) {
+                searchBackward(from, lowerBound, backward);
+            }
+            for (int v : forward) {
+                visited[v] = 0;
+            }
+            for (int v : backward) {
+                visited[v] = 0;
+            }
+            if (!acyclic) {
+                return false;
+            }
+
+            // Everything that reaches from now goes before everything reachable from to, reusing
+            // the same set of positions
+            auto byOrder = [this](int a, int b) { return order[a] < order[b]; };
+            std::sort(forward.begin(), forward.end(), byOrder);
+            std::sort(backward.begin(), backward.end(), byOrder);
+            std::vector<int> positions;
+            positions.reserve(forward.size() + backward.size());
+            for (int v : backward) {
+                positions.push_back(order[v]);
+            }
+            for (int v : forward) {
+                positions.push_back(order[v]);
+            }
+            std::sort(positions.begin(), positions.end());
+            size_t next = 0;
+            for (int v : backward) {
+                order[v] = positions[next++];
+                vertexAt[order[v]] = v;
+            }
+            for (int v : forward) {
+                order[v] = positions[next++];
+                vertexAt[order[v]] = v;
+            }
+        }
+
+        waitsOn[from].push_back(to);
+        waitedBy[to].push_back(from);
+        return true;
     }
 
+    // Removing an edge never invalidates the topological order, so this is O(degree)
+    bool removeEdge(int fromId, int toId) {
+        auto from = vertexOf.find(fromId);
+        auto to = vertexOf.find(toId);
+        if (from == vertexOf.end() || to == vertexOf.end() || !eraseOne(waitsOn[from->second], to->second)) {
+            return false;
+        }
+        eraseOne(waitedBy[to->second], from->second);
+        return true;
+    }
+
+    size_t processCount() const { return ids.size(); }
+
+    // Processes on the cycle the last rejected edge would have closed, starting with the waiting process
+    const std::vector<int>& getLastCycle() const { return lastCycle; }
+};
+
+class DeadlockDetector {
+private:
+    std::vector<Resource> resources;
+    std::vector<Process> processes;
+
 public:
     DeadlockDetector(const std::vector<Resource>& resourceList, 
                      const std::vector<Process>& processList)
         : resources(resourceList), processes(processList) {}
 
-    bool detectDeadlock(const std::unordered_map<int, std::unordered_set<int>>& graph) {
-        // Create a copy of the graph to avoid modifying the input
-        auto graphCopy = graph;
-        return hasCycle(graphCopy);
+    // Detection algorithm for resources with several instances (Available / Allocation / Request
+    // matrix reduction), read straight from the Process and Resource state. A process finishes if
+    // all of its requests fit in work, then returns its allocation to work; whatever never finishes
+    // is deadlocked. Each resource keeps its blocked requests sorted by size with a cursor past those
+    // that now fit, so a process is queued exactly when its last unmet request becomes satisfiable.
+    // Runs in O(R log R) for R outstanding requests plus the size of the allocations.
+    std::vector<int> findDeadlockedProcesses() const {
+        std::unordered_map<int, int> columnOf;
+        std::vector<long long> work(resources.size());
+        for (size_t j = 0; j < resources.size(); ++j) {
+            columnOf[resources[j].getId()] = static_cast<int>(j);
+            work[j] = resources[j].getAvailableInstances();
+        }
+        auto column = [&columnOf](int resourceId) {
+            auto it = columnOf.find(resourceId);
+            if (it == columnOf.end()) {
+                throw std::invalid_argument("Process refers to unknown resource " + std::to_string(resourceId));
+            }
+            return it->second;
+        };
+
+        // Requests that cannot be met yet, per resource: (instances, process)
+        std::vector<std::vector<std::pair<int, int>>> blockedRequests(resources.size());
+        std::vector<int> unmetRequests(processes.size(), 0);
+        std::vector<int> workQueue;
+        for (size_t i = 0; i < processes.size(); ++i) {
+            for (const auto& [resourceId, instances] : processes[i].getRequestedResources()) {
+                int j = column(resourceId);
+                if (instances > work[j]) {
+                    blockedRequests[j].push_back({instances, static_cast<int>(i)});
+                    unmetRequests[i]++;
+                }
+            }
+            if (unmetRequests[i] == 0) {
+                workQueue.push_back(static_cast<int>(i));
+            }
+        }
+        for (auto& requests : blockedRequests) {
+            std::sort(requests.begin(), requests.end());
+        }
+
+        std::vector<size_t> cursor(resources.size(), 0);
+        for (size_t next = 0; next < workQueue.size(); ++next) {
+            for (const auto& [resourceId, instances] : processes[workQueue[next]].getAllocatedResources()) {
+                int j = column(resourceId);
+                work[j] += instances;
+                const auto& requests = blockedRequests[j];
+                while (cursor[j] < requests.size() && requests[cursor[j]].first <= work[j]) {
+                    int waiting = requests[cursor[j]++].second;
+                    if (--unmetRequests[waiting] == 0) {
+                        workQueue.push_back(waiting);
+                    }
+                }
+            }
+        }
+
+        std::vector<int> deadlocked;
+        for (size_t i = 0; i < processes.size(); ++i) {
+            if (unmetRequests[i] > 0) {
+                deadlocked.push_back(processes[i].getId());
+            }
+        }
+        std::sort(deadlocked.begin(), deadlocked.end());
+        return deadlocked;
+    }
+
+    std::vector<std::vector<int>> findDeadlockedSets(const std::unordered_map<int, std::unordered_set<int>>& graph) const {
+        return WaitForGraph::fromAdjacency(graph, processes).deadlockedSets();
+    }
+
+    bool detectDeadlock(const std::unordered_map<int, std::unordered_set<int>>& graph) const {
+        return !findDeadlockedSets(graph).empty();
     }
 
     void printDeadlockStatus(const std::unordered_map<int, std::unordered_set<int>>& graph) {
-        bool deadlockDetected = detectDeadlock(graph);
+        std::vector<std::vector<int>> deadlockedSets = findDeadlockedSets(graph);
         
         std::cout << "Deadlock Detection Results:" << std::endl;
-        std::cout << "Deadlock Exists: " << (deadlockDetected ? "Yes" : "No") << std::endl;
+        std::cout << "Deadlock Exists: " << (deadlockedSets.empty() ? "No" : "Yes") << std::endl;
+        for (const auto& deadlocked : deadlockedSets) {
+            std::cout << "Deadlocked Processes:";
+            for (int processId : deadlocked) {
+                std::cout << " " << processId;
+            }
+            std::cout << std::endl;
+        }
+
+        std::vector<int> deadlockedProcesses = findDeadlockedProcesses();
+        std::cout << "Deadlocked Processes (from resource state):";
+        if (deadlockedProcesses.empty()) {
+            std::cout << " None";
+        }
+        for (int processId : deadlockedProcesses) {
+            std::cout << " " << processId;
+        }
+        std::cout << std::endl;
 
         // Print resource allocation details
         std::cout << "\nResource Allocation Details:" << std::endl;
@@ -137,7 +745,599 @@ public:
     }
 };
 
-int main() {
+// Thrown out of ResourceManager::acquire in a thread whose process was aborted to break a deadlock.
+// All of the process's resources have been released by the time it is thrown.
+class ProcessAborted : public std::runtime_error {
+public:
+    ProcessAborted(int processId)
+        : std::runtime_error("Process " + std::to_string(processId) + " aborted to break a deadlock") {}
+};
+
+// Thread-safe resource manager: threads block in acquire() until enough instances are free. Resources
+// are split over lock stripes so threads working on different resources rarely contend. A detector
+// thread periodically snapshots one stripe at a time, runs the multi-instance detection on the
+// processes that stayed blocked for the whole snapshot and aborts a victim from each deadlock.
+class ResourceManager {
+private:
+    struct Waiter {
+        int processId;
+        int instances;
+        long long ticket;
+    };
+
+    struct ResourceSlot {
+        int total = 0;
+        int available = 0;
+        std::unordered_map<int, int> holders;  // Process id -> instances held
+        std::vector<Waiter> waiters;
+    };
+
+    struct alignas(64) Stripe {
+        std::mutex mutex;
+        std::condition_variable released;
+    };
+
+    struct alignas(64) ProcessSlot {
+        std::atomic<bool> aborted{false};
+        std::atomic<long long> waitTicket{-1};    // Ticket of the wait in progress, -1 while running
+        std::atomic<long long> waitStartNanos{0};
+        std::atomic<int> heldInstances{0};
+        std::vector<std::pair<int, int>> held;    // (resource, instances); only touched by the process's thread
+    };
+
+    std::vector<ResourceSlot> resourceSlots;
+    std::vector<Stripe> stripes;
+    std::vector<ProcessSlot> processSlots;
+    std::atomic<long long> nextTicket{0};
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    std::thread detector;
+    std::mutex detectorMutex;
+    std::condition_variable detectorWake;
+    bool stopping = false;
+
+    // Written by the detector thread only
+    size_t detectionRuns = 0;
+    size_t victims = 0;
+    long long totalLatencyNanos = 0;
+    long long maxLatencyNanos = 0;
+
+    long long nowNanos() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    Stripe& stripeOf(int resourceId) { return stripes[resourceId % stripes.size()]; }
+
+    void validate(int processId, int resourceId, int instances) const {
+        if (processId < 0 || processId >= static_cast<int>(processSlots.size()) ||
+            resourceId < 0 || resourceId >= static_cast<int>(resourceSlots.size()) || instances <= 0) {
+            throw std::invalid_argument("Invalid process, resource or instance count");
+        }
+    }
+
+    // Caller holds the resource's stripe lock
+    void returnInstances(int processId, int resourceId, int instances) {
+        ResourceSlot& slot = resourceSlots[resourceId];
+        auto holder = slot.holders.find(processId);
+        if (holder == slot.holders.end() || holder->second < instances) {
+            throw std::invalid_argument("Process cannot release more than it holds");
+        }
+        if ((holder->second -= instances) == 0) {
+            slot.holders.erase(holder);
+        }
+        slot.available += instances;
+        processSlots[processId].heldInstances -= instances;
+    }
+
+    void abortProcess(int processId) {
+        processSlots[processId].aborted = false;
+        releaseAll(processId);
+        throw ProcessAborted(processId);
+    }
+
+    void detectorLoop(std::chrono::microseconds interval) {
+        std::unique_lock<std::mutex> lock(detectorMutex);
+        while (!detectorWake.wait_for(lock, interval, [this] { return stopping; })) {
+            lock.unlock();
+            detectAndRecover();
+            lock.lock();
+        }
+    }
+
+public:
+    ResourceManager(const std::vector<int>& instancesPerResource, int processCount, int stripeCount = 64)
+        : resourceSlots(instancesPerResource.size()), stripes(std::max(1, stripeCount)), processSlots(processCount) {
+        for (size_t r = 0; r < instancesPerResource.size(); ++r) {
+            resourceSlots[r].total = resourceSlots[r].available = instancesPerResource[r];
+        }
+    }
+
+    ~ResourceManager() { stopDetector(); }
+
+    // Blocks until the instances are granted; throws ProcessAborted if the process is chosen as a victim
+    void acquire(int processId, int resourceId, int instances) {
+        validate(processId, resourceId, instances);
+        ProcessSlot& process = processSlots[processId];
+        if (process.aborted) {
+            abortProcess(processId);
+        }
+
+        ResourceSlot& slot = resourceSlots[resourceId];
+        Stripe& stripe = stripeOf(resourceId);
+        std::unique_lock<std::mutex> lock(stripe.mutex);
+        if (slot.available < instances) {
+            long long ticket = ++nextTicket;
+            slot.waiters.push_back({processId, instances, ticket});
+            process.waitStartNanos = nowNanos();
+            process.waitTicket = ticket;
+            stripe.released.wait(lock, [&] { return slot.available >= instances || process.aborted; });
+            process.waitTicket = -1;
+            slot.waiters.erase(std::find_if(slot.waiters.begin(), slot.waiters.end(),
+                                            [ticket](const Waiter& w) { return w.ticket == ticket; }));
+            if (process.aborted) {
+                lock.unlock();
+                abortProcess(processId);
+            }
+        }
+        slot.available -= instances;
+        slot.holders[processId] += instances;
+        process.heldInstances += instances;
+        lock.unlock();
+        process.held.push_back({resourceId, instances});
+    }
+
+    void release(int processId, int resourceId, int instances) {
+        validate(processId, resourceId, instances);
+        {
+            std::lock_guard<std::mutex> lock(stripeOf(resourceId).mutex);
+            returnInstances(processId, resourceId, instances);
+        }
+        stripeOf(resourceId).released.notify_all();
+
+        auto& held = processSlots[processId].held;
+        for (auto it = held.begin(); it != held.end() && instances > 0; ) {
+            if (it->first != resourceId) {
+                ++it;
+                continue;
+            }
+            int taken = std::min(instances, it->second);
+            instances -= taken;
+            if ((it->second -= taken) == 0) {
+                it = held.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    void releaseAll(int processId) {
+        auto& held = processSlots[processId].held;
+        for (const auto& [resourceId, instances] : held) {
+            {
+                std::lock_guard<std::mutex> lock(stripeOf(resourceId).mutex);
+                returnInstances(processId, resourceId, instances);
+            }
+            stripeOf(resourceId).released.notify_all();
+        }
+        held.clear();
+    }
+
+    // One detection pass. Only processes whose wait began before the snapshot and is still the
+    // same wait afterwards are treated as blocked: they cannot have changed their holdings while
+    // the stripes were read one by one, so a deadlock among them is real. Every other process is
+    // assumed to finish. Returns the number of victims aborted.
+    size_t detectAndRecover() {
+        long long snapshotTicket = ++nextTicket;
+        std::vector<Resource> resources;
+        std::vector<Process> processes;
+        std::unordered_map<int, size_t> processIndex;
+        std::unordered_map<int, long long> blockedTicket;
+        auto process = [&](int processId) -> Process& {
+            auto [it, inserted] = processIndex.emplace(processId, processes.size());
+            if (inserted) {
+                processes.push_back(Process(processId));
+            }
+            return processes[it->second];
+        };
+
+        resources.reserve(resourceSlots.size());
+        for (size_t r = 0; r < resourceSlots.size(); ++r) {
+            resources.push_back(Resource(static_cast<int>(r), resourceSlots[r].total));
+        }
+        for (size_t s = 0; s < stripes.size(); ++s) {
+            std::lock_guard<std::mutex> lock(stripes[s].mutex);
+            for (size_t r = s; r < resourceSlots.size(); r += stripes.size()) {
+                const ResourceSlot& slot = resourceSlots[r];
+                resources[r].allocate(slot.total - slot.available);
+                for (const auto& [processId, instances] : slot.holders) {
+                    Process& holder = process(processId);
+                    holder.requestResource(static_cast<int>(r), instances);
+                    holder.allocateResource(static_cast<int>(r), instances);
+                }
+                for (const Waiter& waiter : slot.waiters) {
+                    if (waiter.ticket < snapshotTicket && !processSlots[waiter.processId].aborted) {
+                        process(waiter.processId).requestResource(static_cast<int>(r), waiter.instances);
+                        blockedTicket[waiter.processId] = waiter.ticket;
+                    }
+                }
+            }
+        }
+        detectionRuns++;
+
+        size_t aborted = 0;
+        while (true) {
+            std::vector<int> deadlocked = DeadlockDetector(resources, processes).findDeadlockedProcesses();
+            if (deadlocked.empty()) {
+                break;
+            }
+
+            for (int processId : deadlocked) {
+                if (processSlots[processId].waitTicket != blockedTicket[processId]) {
+                    return aborted;  // Woke up since the snapshot; the next pass will see the new state
+                }
+            }
+
+            // Processes merely queued behind a deadlock are reported too, so victims come from a cycle.
+            // Only requests that stay unmet once every other process finishes are wait-for edges.
+            std::unordered_set<int> deadlockedSet(deadlocked.begin(), deadlocked.end());
+            std::vector<long long> work(resources.size());
+            for (size_t r = 0; r < resources.size(); ++r) {
+                work[r] = resources[r].getAvailableInstances();
+            }
+            std::unordered_map<int, std::vector<int>> holdersOf;
+            for (const Process& p : processes) {
+                for (const auto& [r, instances] : p.getAllocatedResources()) {
+                    if (deadlockedSet.count(p.getId())) {
+                        holdersOf[r].push_back(p.getId());
+                    } else {
+                        work[r] += instances;
+                    }
+                }
+            }
+            std::unordered_map<int, std::unordered_set<int>> waitsOn;
+            for (int processId : deadlocked) {
+                for (const auto& [r, instances] : processes[processIndex[processId]].getRequestedResources()) {
+                    if (instances > work[r]) {
+                        waitsOn[processId].insert(holdersOf[r].begin(), holdersOf[r].end());
+                    }
+                }
+            }
+            std::vector<std::vector<int>> cycles = WaitForGraph::fromAdjacency(waitsOn, {}).deadlockedSets();
+            if (cycles.empty()) {
+                break;  // Cannot happen: every deadlocked process waits on a deadlocked holder
+            }
+
+            // Victim from the first cycle: holds something, fewest instances held (least work lost),
+            // then the most recent wait. The cycle formed when its last member started waiting.
+            int victim = -1;
+            long long formedAt = 0;
+            for (int processId : cycles.front()) {
+                const ProcessSlot& slot = processSlots[processId];
+                formedAt = std::max(formedAt, slot.waitStartNanos.load());
+                if (slot.heldInstances <= 0) {
+                    continue;
+                }
+                if (victim == -1 || slot.heldInstances < processSlots[victim].heldInstances ||
+                    (slot.heldInstances == processSlots[victim].heldInstances &&
+                     blockedTicket[processId] > blockedTicket[victim])) {
+                    victim = processId;
+                }
+            }
+            if (victim == -1) {
+                break;  // Cannot happen: a cycle member waits on another member's instances
+            }
+
+            int resourceId = -1;
+            for (const auto& [r, instances] : processes[processIndex[victim]].getRequestedResources()) {
+                if (instances > 0) {
+                    resourceId = r;
+                }
+            }
+            {
+                std::lock_guard<std::mutex> lock(stripeOf(resourceId).mutex);
+                processSlots[victim].aborted = true;
+            }
+            stripeOf(resourceId).released.notify_all();
+            aborted++;
+            victims++;
+            long long latency = nowNanos() - formedAt;
+            totalLatencyNanos += latency;
+            maxLatencyNanos = std::max(maxLatencyNanos, latency);
+
+            // The victim will release everything it holds; check whether other deadlocks remain
+            Process released(victim);
+            for (const auto& [r, instances] : processes[processIndex[victim]].getAllocatedResources()) {
+                released.requestResource(r, instances);
+                released.allocateResource(r, instances);
+            }
+            processes[processIndex[victim]] = released;
+        }
+        return aborted;
+    }
+
+    void startDetector(std::chrono::microseconds interval) {
+        stopDetector();
+        stopping = false;
+        detector = std::thread(&ResourceManager::detectorLoop, this, interval);
+    }
+
+    void stopDetector() {
+        if (!detector.joinable()) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(detectorMutex);
+            stopping = true;
+        }
+        detectorWake.notify_all();
+        detector.join();
+    }
+
+    // Read after stopDetector()
+    size_t getDetectionRuns() const { return detectionRuns; }
+    size_t getVictims() const { return victims; }
+    double getMeanLatencyMicros() const { return victims ? totalLatencyNanos / 1000.0 / victims : 0.0; }
+    double getMaxLatencyMicros() const { return maxLatencyNanos / 1000.0; }
+};
+
+// Threads repeatedly lock two or three of a small set of single-instance resources in random
+// order, so deadlocks are frequent; reports throughput and how quickly deadlocks are broken
+void runLockManagerBenchmark() {
+    const int resourceCount = 32;
+    const auto duration = std::chrono::milliseconds(500);
+    int maxThreads = std::max(8u, std::thread::hardware_concurrency());
+
+    std::cout << "Threads\tAcquires/sec\tDetections\tVictims\tMean latency (us)\tMax latency (us)\n";
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        ResourceManager manager(std::vector<int>(resourceCount, 1), threads, 16);
+        manager.startDetector(std::chrono::microseconds(1000));
+        std::atomic<bool> running(true);
+        std::atomic<long long> acquires(0);
+
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t]() {
+                std::mt19937 generator(t + 1);
+                std::uniform_int_distribution<int> anyResource(0, resourceCount - 1);
+                long long local = 0;
+                while (running) {
+                    int lockCount = 2 + static_cast<int>(generator() % 2);
+                    std::vector<int> wanted;
+                    while (static_cast<int>(wanted.size()) < lockCount) {
+                        int r = anyResource(generator);
+                        if (std::find(wanted.begin(), wanted.end(), r) == wanted.end()) {
+                            wanted.push_back(r);
+                        }
+                    }
+                    try {
+                        for (int r : wanted) {
+                            manager.acquire(t, r, 1);
+                            local++;
+                        }
+                        manager.releaseAll(t);
+                    }
+                    catch (const ProcessAborted&) {
+                        // Resources are already released; simply retry with new work
+                    }
+                }
+                acquires += local;
+            });
+        }
+
+        std::this_thread::sleep_for(duration);
+        running = false;
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        manager.stopDetector();
+
+        std::cout << threads << "\t" << acquires / std::chrono::duration<double>(duration).count() << "\t"
+                  << manager.getDetectionRuns() << "\t\t" << manager.getVictims() << "\t"
+                  << manager.getMeanLatencyMicros() << "\t\t\t" << manager.getMaxLatencyMicros() << "\n";
+    }
+}
+
+// Bytes currently allocated through CountingAllocator
+size_t countedBytes = 0;
+
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() = default;
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        countedBytes += n * sizeof(T);
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) {
+        countedBytes -= n * sizeof(T);
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const CountingAllocator<U>&) const { return false; }
+};
+
+// Times the SCC pass on a single wait chain closed into one cycle (deepest possible search) and on
+// a random graph with four waits per process, then the matrix reduction and the incremental graph
+void runBenchmark() {
+    const int vertexCount = 5000000;
+    std::vector<int> ids(vertexCount);
+    for (int v = 0; v < vertexCount; ++v) {
+        ids[v] = v;
+    }
+
+    std::vector<std::pair<int, int>> chain;
+    chain.reserve(vertexCount);
+    for (int v = 0; v < vertexCount; ++v) {
+        chain.push_back({v, (v + 1) % vertexCount});
+    }
+
+    std::mt19937 generator(11);
+    std::uniform_int_distribution<int> anyVertex(0, vertexCount - 1);
+    std::vector<std::pair<int, int>> random;
+    random.reserve(4LL * vertexCount);
+    for (long long e = 0; e < 4LL * vertexCount; ++e) {
+        random.push_back({anyVertex(generator), anyVertex(generator)});
+    }
+
+    std::cout << "Graph\tVertices\tEdges\t\tBuild (s)\tSCC (s)\tDeadlocked sets\tLargest set\n";
+    for (const auto& [name, edges] : {std::make_pair("chain", &chain), std::make_pair("random", &random)}) {
+        auto start = std::chrono::steady_clock::now();
+        WaitForGraph graph(ids, *edges);
+        auto built = std::chrono::steady_clock::now();
+        std::vector<std::vector<int>> deadlocked = graph.deadlockedSets();
+        auto done = std::chrono::steady_clock::now();
+
+        size_t largest = 0;
+        for (const auto& set : deadlocked) {
+            largest = std::max(largest, set.size());
+        }
+        std::cout << name << "\t" << graph.vertexCount() << "\t\t" << graph.edgeCount() << "\t"
+                  << std::chrono::duration<double>(built - start).count() << "\t"
+                  << std::chrono::duration<double>(done - built).count() << "\t"
+                  << deadlocked.size() << "\t\t" << largest << "\n";
+    }
+
+    // Matrix reduction on 100k processes and 1k resource types: each process holds up to four
+    // resource types and requests two more
+    const int resourceTypes = 1000;
+    const int reductionProcesses = 100000;
+    std::vector<Resource> resources;
+    for (int r = 0; r < resourceTypes; ++r) {
+        resources.push_back(Resource(r, 800));
+    }
+    std::uniform_int_distribution<int> anyResource(0, resourceTypes - 1);
+    std::uniform_int_distribution<int> instances(1, 3);
+    std::vector<Process> processes;
+    processes.reserve(reductionProcesses);
+    for (int p = 0; p < reductionProcesses; ++p) {
+        Process process(p);
+        for (int k = 0; k < 4; ++k) {
+            Resource& resource = resources[anyResource(generator)];
+            int count = instances(generator);
+            if (resource.getAvailableInstances() >= count) {
+                resource.allocate(count);
+                process.requestResource(resource.getId(), count);
+                process.allocateResource(resource.getId(), count);
+            }
+        }
+        for (int k = 0; k < 2; ++k) {
+            process.requestResource(anyResource(generator), instances(generator));
+        }
+        processes.push_back(std::move(process));
+    }
+    // Mixed block sizes: one process spread over 70000 resource types takes an oversized arena block,
+    // then many small processes must still get blocks of their own
+    {
+        Process wide(-1);
+        for (int r = 0; r < 70000; ++r) {
+            wide.requestResource(r, 1);
+        }
+        std::vector<Process> small;
+        for (int p = 0; p < 1000; ++p) {
+            small.push_back(Process(p));
+            for (int r = 0; r < 6; ++r) {
+                small.back().requestResource(r * 3, p + r + 1);
+            }
+        }
+        for (int p = 0; p < 1000; ++p) {
+            for (int r = 0; r < 6; ++r) {
+                int instances = 0;
+                for (const auto& [resourceId, count] : small[p].getRequestedResources()) {
+                    instances += resourceId == r * 3 ? count : 0;
+                }
+                if (instances != p + r + 1) {
+                    throw std::runtime_error("Resource arena handed out overlapping blocks");
+                }
+            }
+        }
+        size_t wideEntries = 0;
+        for (const auto& entry : wide.getRequestedResources()) {
+            wideEntries += entry.second == 1;
+        }
+        if (wideEntries != 70000) {
+            throw std::runtime_error("Resource arena handed out overlapping blocks");
+        }
+    }
+
+    // Footprint of the same entries in the two unordered_maps per process used before
+    size_t compactBytes = 0;
+    size_t mapBytes = 0;
+    for (const Process& process : processes) {
+        compactBytes += process.memoryUsage();
+        countedBytes = 0;
+        {
+            std::unordered_map<int, int, std::hash<int>, std::equal_to<int>, CountingAllocator<std::pair<const int, int>>> allocated, requested;
+            for (const auto& [resourceId, count] : process.getAllocatedResources()) {
+                allocated[resourceId] = count;
+                requested[resourceId] = 0;  // allocateResource left a zero request behind
+            }
+            for (const auto& [resourceId, count] : process.getRequestedResources()) {
+                requested[resourceId] = count;
+            }
+            mapBytes += sizeof(int) + sizeof(allocated) + sizeof(requested) + countedBytes;
+        }
+    }
+    std::cout << "\nProcess storage: " << compactBytes / reductionProcesses << " bytes per process ("
+              << mapBytes / reductionProcesses << " with unordered_map)\n";
+
+    DeadlockDetector detector(resources, processes);
+    auto reductionStart = std::chrono::steady_clock::now();
+    size_t deadlockedCount = detector.findDeadlockedProcesses().size();
+    std::chrono::duration<double> reductionTime = std::chrono::steady_clock::now() - reductionStart;
+    std::cout << "Matrix reduction: " << reductionProcesses << " processes x " << resourceTypes
+              << " resource types in " << reductionTime.count() << " seconds, "
+              << deadlockedCount << " deadlocked\n";
+
+    // Lock-manager style churn: keep one live wait for every two processes, adding a random wait
+    // and retiring the oldest one on every step
+    const int processCount = 100000;
+    const int liveEdges = processCount / 2;
+    const int operations = 2000000;
+    std::uniform_int_distribution<int> anyProcess(0, processCount - 1);
+    DynamicWaitForGraph dynamicGraph;
+    std::vector<std::pair<int, int>> live(liveEdges, {-1, -1});
+    size_t rejected = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int op = 0; op < operations; ++op) {
+        auto& slot = live[op % liveEdges];
+        if (slot.first != -1) {
+            dynamicGraph.removeEdge(slot.first, slot.second);
+        }
+        int from = anyProcess(generator);
+        int to = anyProcess(generator);
+        if (dynamicGraph.addEdge(from, to)) {
+            slot = {from, to};
+        } else {
+            slot = {-1, -1};
+            rejected++;
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "\nIncremental: " << operations << " waits over " << processCount << " processes in "
+              << elapsed.count() << " seconds (" << operations / elapsed.count() << " per second), "
+              << rejected << " would have deadlocked\n";
+}
+
+// Usage: DeadlockDetection [--bench | --lock-bench]
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "--bench") {
+        runBenchmark();
+        return 0;
+    }
+    if (argc > 1 && std::string(argv[1]) == "--lock-bench") {
+        runLockManagerBenchmark();
+        return 0;
+    }
+
     // Input resources in main function
     std::vector<Resource> resources = {
         Resource(1, 3),   // Resource 1 has 3 instances
@@ -160,6 +1360,14 @@ int main() {
     processes[0].allocateResource(1, 2);  // Allocate requested resources
     processes[1].allocateResource(2, 1);
     processes[2].allocateResource(3, 1);
+    resources[0].allocate(2);
+    resources[1].allocate(1);
+    resources[2].allocate(1);
+
+    // Each process now waits for more than is available: a circular wait
+    processes[0].requestResource(2, 2);   // Process 0 requests 2 instances of Resource 2 (1 available)
+    processes[1].requestResource(3, 1);   // Process 1 requests Resource 3, held by Process 2
+    processes[2].requestResource(1, 2);   // Process 2 requests 2 instances of Resource 1 (1 available)
 
     // Create deadlock graph in main function
     std::unordered_map<int, std::unordered_set<int>> graph;
@@ -173,5 +1381,20 @@ int main() {
     // Detect and print deadlock
     detector.printDeadlockStatus(graph);
 
+    // Same waits added one at a time: the wait that closes the cycle is refused
+    DynamicWaitForGraph dynamicGraph;
+    std::cout << "\nIncremental Detection:" << std::endl;
+    for (const auto& [from, to] : {std::make_pair(0, 1), std::make_pair(1, 2), std::make_pair(2, 0)}) {
+        if (dynamicGraph.addEdge(from, to)) {
+            std::cout << "Process " << from << " waits for Process " << to << std::endl;
+        } else {
+            std::cout << "Process " << from << " waiting for Process " << to << " would deadlock:";
+            for (int processId : dynamicGraph.getLastCycle()) {
+                std::cout << " " << processId;
+            }
+            std::cout << std::endl;
+        }
+    }
+
     return 0;
 }
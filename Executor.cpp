@@ -0,0 +1,238 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "SchedulingEngine.h"
+
+using Clock = std::chrono::steady_clock;
+
+// One call performs one time unit of a process's burst
+using WorkItem = std::function<void()>;
+
+struct ExecutorReport {
+    SchedulingStats measured;         // Wall-clock waiting/turnaround/response, converted to time units
+    LatencyHistogram dispatchNanos;   // Lock, policy decision and bookkeeping for one dispatch
+    LatencyHistogram switchNanos;     // End of one slice to start of the next on the same worker
+    size_t slices = 0;
+    size_t preemptions = 0;
+    double wallSeconds = 0;
+    double busySeconds = 0;
+};
+
+// Runs real work items on a pool of worker threads in the order a scheduling policy chooses.
+// Arrivals are released when the wall clock reaches arrivalTime * unitNanos. Workers share one
+// policy-ordered ready queue; a running work item is preempted cooperatively at unit boundaries,
+// either when its slice is used up or, for preemptive policies, when a new arrival is due.
+template <typename Policy>
+class PolicyExecutor {
+private:
+    Policy policy;
+    int workers;
+
+public:
+    PolicyExecutor(Policy p, int workerCount) : policy(std::move(p)), workers(workerCount) {
+        // MLFQ remembers the level of the last dispatch until its requeue, so it needs a single worker
+        if (workers <= 0 || (std::is_same<Policy, MLFQPolicy>::value && workers != 1)) {
+            throw std::invalid_argument("Invalid executor worker count");
+        }
+    }
+
+    ExecutorReport run(const ProcessTable& table, const std::vector<WorkItem>& work, long long unitNanos) const {
+        size_t n = table.size();
+        Policy readyQueue = policy;
+        std::vector<int> remainingTime(table.burstTime);
+        std::vector<bool> started(n, false);
+
+        std::vector<int> arrivalOrder(n);
+        std::iota(arrivalOrder.begin(), arrivalOrder.end(), 0);
+        std::stable_sort(arrivalOrder.begin(), arrivalOrder.end(), [&table](int a, int b) {
+            return table.arrivalTime[a] < table.arrivalTime[b];
+        });
+
+        std::mutex mutex;
+        std::condition_variable workAvailable;
+        size_t nextArrival = 0;
+        size_t completedProcesses = 0;
+        // Release time of the next arrival, read lock-free by running workers to decide on preemption
+        std::atomic<long long> nextReleaseNanos(n ? table.arrivalTime[arrivalOrder[0]] * unitNanos : 0);
+        ExecutorReport report;
+
+        Clock::time_point start = Clock::now();
+        auto elapsedNanos = [&start]() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+        };
+
+        auto worker = [&]() {
+            ExecutorReport local;
+            long long lastSliceEnd = -1;  // -1 after idling, so waits for work are not counted as switches
+
+            std::unique_lock<std::mutex> lock(mutex);
+            while (completedProcesses < n) {
+                long long now = elapsedNanos();
+                while (nextArrival < n && table.arrivalTime[arrivalOrder[nextArrival]] * unitNanos <= now) {
+                    int index = arrivalOrder[nextArrival++];
+                    readyQueue.push(table, index, remainingTime[index]);
+                    workAvailable.notify_one();
+                }
+                nextReleaseNanos = nextArrival < n ? table.arrivalTime[arrivalOrder[nextArrival]] * unitNanos : LLONG_MAX;
+
+                if (readyQueue.empty()) {
+                    if (nextArrival < n) {
+                        workAvailable.wait_until(lock, start + std::chrono::nanoseconds(nextReleaseNanos.load()));
+                    } else {
+                        workAvailable.wait(lock);  // Woken by a requeue or by the last completion
+                    }
+                    lastSliceEnd = -1;
+                    continue;
+                }
+
+                long long dispatchStart = elapsedNanos();
+                int index = readyQueue.pop(dispatchStart / unitNanos);
+                int slice = readyQueue.timeSlice(index, remainingTime[index]);
+                if (!started[index]) {
+                    started[index] = true;
+                    local.measured.recordResponse(dispatchStart / unitNanos - table.arrivalTime[index]);
+                }
+                long long sliceStart = elapsedNanos();
+                local.dispatchNanos.record(sliceStart - dispatchStart);
+                if (lastSliceEnd >= 0) {
+                    local.switchNanos.record(sliceStart - lastSliceEnd);
+                }
+                lock.unlock();
+
+                int ranFor = 0;
+                while (ranFor < slice) {
+                    work[index]();
+                    ranFor++;
+                    if (Policy::preemptive && ranFor < slice && elapsedNanos() >= nextReleaseNanos.load()) {
+                        local.preemptions++;
+                        break;
+                    }
+                }
+                lastSliceEnd = elapsedNanos();
+                local.busySeconds += (lastSliceEnd - sliceStart) / 1e9;
+                local.slices++;
+
+                lock.lock();
+                remainingTime[index] -= ranFor;
+                if (remainingTime[index] > 0) {
+                    readyQueue.requeue(table, index, remainingTime[index], ranFor);
+                    workAvailable.notify_one();
+                } else {
+                    long long turnaroundTime = lastSliceEnd / unitNanos - table.arrivalTime[index];
+                    local.measured.recordCompletion(turnaroundTime - table.burstTime[index], turnaroundTime);
+                    if (++completedProcesses == n) {
+                        workAvailable.notify_all();
+                    }
+                }
+            }
+
+            report.measured.merge(local.measured);
+            report.dispatchNanos.merge(local.dispatchNanos);
+            report.switchNanos.merge(local.switchNanos);
+            report.slices += local.slices;
+            report.preemptions += local.preemptions;
+            report.busySeconds += local.busySeconds;
+        };
+
+        std::vector<std::thread> pool;
+        for (int w = 0; w < workers; ++w) {
+            pool.emplace_back(worker);
+        }
+        for (auto& thread : pool) {
+            thread.join();
+        }
+        report.wallSeconds = elapsedNanos() / 1e9;
+        return report;
+    }
+};
+
+// Average cost of one work unit, used as the length of one simulated time unit
+long long calibrateUnitNanos(const WorkItem& unit) {
+    const int samples = 200;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < samples; ++i) {
+        unit();
+    }
+    long long total = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    return std::max(1LL, total / samples);
+}
+
+template <typename Policy>
+void compare(const ProcessTable& table, const std::vector<WorkItem>& work, long long unitNanos, Policy policy, int workers) {
+    SchedulingEngine<Policy> engine(policy);
+    PolicyExecutor<Policy> executor(policy, workers);
+    ExecutorReport report = executor.run(table, work, unitNanos);
+
+    std::cout << "Testing " << engine.name() << " on " << workers << " worker(s):\n";
+    // The engine models a single CPU, so its numbers are only comparable to a one-worker run
+    if (workers == 1) {
+        std::cout << "Simulated:\n";
+        engine.collectStats(table).display();
+        std::cout << "Measured:\n";
+    } else {
+        std::cout << "Measured only (the simulation models one CPU):\n";
+    }
+    report.measured.display();
+    std::cout << "Slices: " << report.slices << ", preemptions: " << report.preemptions
+              << ", utilization: " << report.busySeconds / (report.wallSeconds * workers) << "\n";
+    std::cout << "Dispatch overhead (ns): mean " << report.dispatchNanos.mean()
+              << ", p99 " << report.dispatchNanos.percentile(0.99) << "\n";
+    std::cout << "Context switch (ns): mean " << report.switchNanos.mean()
+              << ", p99 " << report.switchNanos.percentile(0.99) << "\n\n";
+}
+
+// Usage: Executor [workers]
+int main(int argc, char* argv[]) {
+    try {
+        int workers = argc > 1 ? std::stoi(argv[1]) : 1;
+
+        // Each process does one unit of arithmetic work per time unit
+        std::vector<double> accumulators(200, 0.0);
+        std::vector<WorkItem> work;
+        for (size_t i = 0; i < accumulators.size(); ++i) {
+            work.push_back([&accumulators, i]() {
+                double value = accumulators[i];
+                for (int k = 0; k < 20000; ++k) {
+                    value = value * 0.999999 + k;
+                }
+                accumulators[i] = value;
+            });
+        }
+        long long unitNanos = calibrateUnitNanos(work[0]);
+
+        // Add processes: (id, arrival time, burst time, priority)
+        ProcessTable table;
+        std::mt19937 generator(7);
+        std::uniform_int_distribution<int> gap(0, 6);
+        std::uniform_int_distribution<int> burst(1, 10);
+        std::uniform_int_distribution<int> priority(0, 4);
+        int arrival = 0;
+        for (size_t id = 1; id <= work.size(); ++id) {
+            arrival += gap(generator);
+            table.addProcess(id, arrival, burst(generator), priority(generator));
+        }
+
+        std::cout << "One time unit = " << unitNanos << " ns of work\n\n";
+        compare(table, work, unitNanos, FCFSPolicy(), workers);
+        compare(table, work, unitNanos, SJFPolicy(), workers);
+        compare(table, work, unitNanos, RoundRobinPolicy(2), workers);
+        compare(table, work, unitNanos, PriorityPolicy(), workers);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
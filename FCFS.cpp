@@ -1,87 +1,248 @@
+#include <algorithm>
 #include <iostream>
-#include <queue>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
 #include <vector>
+#include "SchedulingEngine.h"
 
-class Process {
-private:
+// One job's waiting and turnaround time as the online scheduler currently sees it
+struct JobTimes {
     int id;
     int arrivalTime;
     int burstTime;
-    int waitingTime;
-    int turnaroundTime;
+    long long waitingTime;
+    long long turnaroundTime;
+};
 
-public:
-    Process(int id, int arrivalTime, int burstTime)
-        : id(id), arrivalTime(arrivalTime), burstTime(burstTime), waitingTime(0), turnaroundTime(0) {}
+// Online FCFS: jobs are submitted one at a time, possibly out of arrival order. They are kept in a
+// treap ordered by (arrival time, submission order) where every subtree stores its total burst and the
+// time its last job would finish if the CPU were free before it. Completion times are then combined
+// along one root-to-leaf path, so submitting a job, looking up its current waiting/turnaround time by
+// id (the id maps to its node, whose key locates the path) and projecting the wait of a job that has
+// not been submitted yet are all O(log n) expected, and a late arrival never forces a recompute of the
+// jobs behind it.
+class OnlineFCFS_Scheduler {
+private:
+    static constexpr long long NO_JOBS = std::numeric_limits<long long>::min() / 4;
+
+    struct Node {
+        int id;
+        int arrivalTime;
+        int burstTime;
+        long long sequence;  // Submission order, breaks ties between equal arrival times
+        unsigned priority;
+        int left;
+        int right;
+        long long burstSum;    // Total burst of the subtree
+        long long finishTime;  // When the subtree's last job finishes if the CPU is free before its first
+    };
+
+    std::vector<Node> nodes;
+    std::unordered_map<int, int> nodeOfId;
+    int root;
+    long long nextSequence;
+    std::mt19937 generator;
+
+    // Finish time of the jobs before a subtree followed by the subtree itself
+    static long long finishAfter(long long finishBefore, long long burstSum, long long finishTime) {
+        return std::max(finishBefore + burstSum, finishTime);
+    }
 
-    int getId() const { return id; }
-    int getArrivalTime() const { return arrivalTime; }
-    int getBurstTime() const { return burstTime; }
-    int getWaitingTime() const { return waitingTime; }
-    int getTurnaroundTime() const { return turnaroundTime; }
+    static bool keyLess(int arrivalA, long long sequenceA, int arrivalB, long long sequenceB) {
+        return arrivalA < arrivalB || (arrivalA == arrivalB && sequenceA < sequenceB);
+    }
 
-    void setWaitingTime(int waiting) { waitingTime = waiting; }
-    void setTurnaroundTime(int turnaround) { turnaroundTime = turnaround; }
-};
+    long long burstSumOf(int node) const { return node == -1 ? 0 : nodes[node].burstSum; }
+    long long finishTimeOf(int node) const { return node == -1 ? NO_JOBS : nodes[node].finishTime; }
 
-class FCFS_Scheduler {
-private:
-    std::vector<Process> processQueue;
+    void update(int node) {
+        Node& n = nodes[node];
+        long long finish = finishTimeOf(n.left);
+        finish = std::max(finish, static_cast<long long>(n.arrivalTime)) + n.burstTime;
+        n.finishTime = finishAfter(finish, burstSumOf(n.right), finishTimeOf(n.right));
+        n.burstSum = burstSumOf(n.left) + n.burstTime + burstSumOf(n.right);
+    }
 
-    void calculateWaitingAndTurnaroundTimes() {
-        int currentTime = 0;
-        for (auto& process : processQueue) {
-            if (currentTime < process.getArrivalTime()) {
-                currentTime = process.getArrivalTime();  // CPU waits for the next process to arrive
+    // Splits into keys before (arrival, sequence) and the rest
+    void split(int node, int arrivalTime, long long sequence, int& left, int& right) {
+        if (node == -1) {
+            left = right = -1;
+            return;
+        }
+        if (keyLess(nodes[node].arrivalTime, nodes[node].sequence, arrivalTime, sequence)) {
+            split(nodes[node].right, arrivalTime, sequence, nodes[node].right, right);
+            left = node;
+        } else {
+            split(nodes[node].left, arrivalTime, sequence, left, nodes[node].left);
+            right = node;
+        }
+        update(node);
+    }
+
+    int merge(int left, int right) {
+        if (left == -1 || right == -1) {
+            return left == -1 ? right : left;
+        }
+        if (nodes[left].priority > nodes[right].priority) {
+            nodes[left].right = merge(nodes[left].right, right);
+            update(left);
+            return left;
+        }
+        nodes[right].left = merge(left, nodes[right].left);
+        update(right);
+        return right;
+    }
+
+    // Time at which every job ordered before (arrival, sequence) has finished
+    long long finishTimeBefore(int arrivalTime, long long sequence) const {
+        long long finish = NO_JOBS;
+        int node = root;
+        while (node != -1) {
+            const Node& n = nodes[node];
+            if (keyLess(n.arrivalTime, n.sequence, arrivalTime, sequence)) {
+                finish = finishAfter(finish, burstSumOf(n.left), finishTimeOf(n.left));
+                finish = std::max(finish, static_cast<long long>(n.arrivalTime)) + n.burstTime;
+                node = n.right;
+            } else {
+                node = n.left;
             }
-            process.setWaitingTime(currentTime - process.getArrivalTime());
-            process.setTurnaroundTime(process.getWaitingTime() + process.getBurstTime());
-            currentTime += process.getBurstTime();
         }
+        return finish;
+    }
+
+    JobTimes timesOf(const Node& n, long long finishBefore) const {
+        long long start = std::max(finishBefore, static_cast<long long>(n.arrivalTime));
+        return {n.id, n.arrivalTime, n.burstTime, start - n.arrivalTime, start + n.burstTime - n.arrivalTime};
     }
 
 public:
-    void addProcess(const Process& process) {
-        processQueue.push_back(process);
+    OnlineFCFS_Scheduler() : root(-1), nextSequence(0), generator(12345) {}
+
+    // Inserts the job in arrival order and returns its waiting and turnaround times as of now
+    // Ids must be unique
+    JobTimes submit(int id, int arrivalTime, int burstTime) {
+        int node = nodes.size();
+        if (!nodeOfId.emplace(id, node).second) {
+            throw std::invalid_argument("Job " + std::to_string(id) + " was already submitted");
+        }
+        nodes.push_back({id, arrivalTime, burstTime, nextSequence++, static_cast<unsigned>(generator()), -1, -1, 0, 0});
+        update(node);
+
+        int left, right;
+        split(root, arrivalTime, nodes[node].sequence, left, right);
+        root = merge(merge(left, node), right);
+        return timesOf(nodes[node], finishTimeBefore(arrivalTime, nodes[node].sequence));
     }
 
-    void run() {
-        calculateWaitingAndTurnaroundTimes();
+    // Waiting and turnaround of a submitted job as of now, including any earlier arrivals submitted after it
+    JobTimes currentTimes(int id) const {
+        auto found = nodeOfId.find(id);
+        if (found == nodeOfId.end()) {
+            throw std::out_of_range("Job " + std::to_string(id) + " was never submitted");
+        }
+        const Node& n = nodes[found->second];
+        return timesOf(n, finishTimeBefore(n.arrivalTime, n.sequence));
     }
 
-    void displayResults() const {
-        int totalWaitingTime = 0;
-        int totalTurnaroundTime = 0;
-
-        std::cout << "PID\tArrival\tBurst\tWaiting\tTurnaround\n";
-        for (const auto& process : processQueue) {
-            std::cout << process.getId() << "\t" 
-                      << process.getArrivalTime() << "\t"
-                      << process.getBurstTime() << "\t"
-                      << process.getWaitingTime() << "\t"
-                      << process.getTurnaroundTime() << "\n";
-
-            totalWaitingTime += process.getWaitingTime();
-            totalTurnaroundTime += process.getTurnaroundTime();
+    // Waiting time a job arriving now would get, without submitting it
+    long long projectedWaitingTime(int arrivalTime) const {
+        long long finishBefore = finishTimeBefore(arrivalTime, std::numeric_limits<long long>::max());
+        return std::max(0LL, finishBefore - arrivalTime);
+    }
+
+    // Current waiting/turnaround of every job, in schedule order
+    std::vector<JobTimes> schedule() const {
+        std::vector<JobTimes> result;
+        result.reserve(nodes.size());
+        std::vector<int> path;
+        long long finish = NO_JOBS;
+        int node = root;
+        while (node != -1 || !path.empty()) {
+            while (node != -1) {
+                path.push_back(node);
+                node = nodes[node].left;
+            }
+            node = path.back();
+            path.pop_back();
+            result.push_back(timesOf(nodes[node], finish));
+            finish = std::max(finish, static_cast<long long>(nodes[node].arrivalTime)) + nodes[node].burstTime;
+            node = nodes[node].right;
         }
+        return result;
+    }
 
-        int n = processQueue.size();
-        std::cout << "\nAverage Waiting Time: " << static_cast<float>(totalWaitingTime) / n << "\n";
-        std::cout << "Average Turnaround Time: " << static_cast<float>(totalTurnaroundTime) / n << "\n";
+    // Prints the schedule with the engine's table layout
+    void displayResults() const {
+        ProcessTable table;
+        ScheduleResult result;
+        for (const JobTimes& job : schedule()) {
+            table.addProcess(job.id, job.arrivalTime, job.burstTime);
+            result.waitingTime.push_back(job.waitingTime);
+            result.turnaroundTime.push_back(job.turnaroundTime);
+        }
+        ::displayResults(table, result);
     }
 };
 
-int main() {
-    FCFS_Scheduler scheduler;
-
+// Usage: FCFS [workload.csv|workload.bin [results.csv|results.bin]]
+int main(int argc, char* argv[]) {
     // Add processes: (id, arrival time, burst time)
-    scheduler.addProcess(Process(1, 0, 5));
-    scheduler.addProcess(Process(2, 2, 3));
-    scheduler.addProcess(Process(3, 4, 1));
-    scheduler.addProcess(Process(4, 6, 7));
-
-    scheduler.run();
-    scheduler.displayResults();
-
-    return 0;
+    ProcessTable demo;
+    demo.addProcess(1, 0, 5);
+    demo.addProcess(2, 2, 3);
+    demo.addProcess(3, 4, 1);
+    demo.addProcess(4, 6, 7);
+
+    int status = runScheduler<FCFSPolicy>(argc, argv, demo);
+    if (argc == 1) {
+        // Online mode: process 3 arrives late but is slotted in by arrival time
+        OnlineFCFS_Scheduler online;
+        online.submit(1, 0, 5);
+        online.submit(2, 2, 3);
+        online.submit(4, 6, 7);
+        JobTimes late = online.submit(3, 4, 1);
+
+        std::cout << "\nOnline FCFS (process 3 submitted last):\n";
+        std::cout << "Process 3 waits " << late.waitingTime << "\n";
+        std::cout << "Process 4 now waits " << online.currentTimes(4).waitingTime << "\n";
+        std::cout << "Projected wait for a job arriving at 10: " << online.projectedWaitingTime(10) << "\n\n";
+        online.displayResults();
+
+        // Brute-force check: shuffled submissions must match the offline engine job for job
+        const int CHECK_JOBS = 2000;
+        std::mt19937 rng(7);
+        ProcessTable jobs;
+        for (int i = 0; i < CHECK_JOBS; ++i) {
+            jobs.addProcess(i, static_cast<int>(rng() % (CHECK_JOBS * 3)), 1 + static_cast<int>(rng() % 10));
+        }
+        std::vector<int> submitOrder(CHECK_JOBS);
+        std::iota(submitOrder.begin(), submitOrder.end(), 0);
+        std::shuffle(submitOrder.begin(), submitOrder.end(), rng);
+
+        // Equal arrivals run in submission order, so the offline table lists jobs in that order
+        ProcessTable offline;
+        OnlineFCFS_Scheduler checked;
+        for (int i : submitOrder) {
+            offline.addProcess(jobs.id[i], jobs.arrivalTime[i], jobs.burstTime[i]);
+            checked.submit(jobs.id[i], jobs.arrivalTime[i], jobs.burstTime[i]);
+        }
+        ScheduleResult expected = SchedulingEngine<FCFSPolicy>().run(offline);
+        int mismatches = 0;
+        for (size_t i = 0; i < offline.size(); ++i) {
+            JobTimes times = checked.currentTimes(offline.id[i]);
+            if (times.waitingTime != expected.waitingTime[i] || times.turnaroundTime != expected.turnaroundTime[i]) {
+                mismatches++;
+            }
+        }
+        std::cout << "\nOnline FCFS vs offline engine on " << CHECK_JOBS << " shuffled submissions: "
+                  << mismatches << " mismatches\n";
+        if (mismatches > 0) {
+            return 1;
+        }
+    }
+    return status;
 }
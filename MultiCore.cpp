@@ -0,0 +1,299 @@
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SchedulingEngine.h"
+
+struct MultiCoreConfig {
+    int cores = 8;
+    int threads = 0;                 // Worker threads driving the cores; 0 uses the hardware concurrency
+    int timeQuantum = 4;             // Round robin quantum of every per-core run queue
+    long long balanceInterval = 16;  // Time between load balancing passes
+    int migrationCost = 2;           // Delay before a stolen process can run on its new core
+};
+
+// Per-core state; aligned so cores driven by different threads never share a cache line
+struct alignas(64) Core {
+    std::deque<int> readyQueue;
+    // Processes placed on this core that are not runnable yet: (ready time, index)
+    std::priority_queue<std::pair<long long, int>, std::vector<std::pair<long long, int>>, std::greater<>> pending;
+    long long currentTime = 0;
+    long long busyTime = 0;
+    long long queuedWork = 0;  // Remaining burst of everything in readyQueue and pending
+    size_t completed = 0;
+    size_t migrationsIn = 0;
+};
+
+// Reusable barrier for the worker threads and the balancer
+class Barrier {
+private:
+    std::mutex mutex;
+    std::condition_variable allArrived;
+    int expected;
+    int waiting;
+    long long generation;
+
+public:
+    Barrier(int count) : expected(count), waiting(0), generation(0) {}
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        long long arrivedGeneration = generation;
+        if (++waiting == expected) {
+            waiting = 0;
+            generation++;
+            allArrived.notify_all();
+        } else {
+            allArrived.wait(lock, [&] { return generation != arrivedGeneration; });
+        }
+    }
+};
+
+// Simulates N cores, each with its own round robin run queue. Time advances in balancing windows:
+// between two balancing passes the cores cannot interact, so each core simulates its window on a
+// worker thread; at the window boundary the balancer places new arrivals on the least loaded cores
+// and idle cores steal half of the busiest core's queue, paying migrationCost per stolen process.
+// Results are deterministic whatever the number of threads.
+class MultiCoreSimulator {
+private:
+    MultiCoreConfig config;
+    std::vector<Core> cores;
+    std::vector<int> remainingTime;
+    std::vector<long long> completionTime;
+    long long makespan = 0;
+
+    void runCoreUntil(Core& core, long long windowEnd) {
+        auto admitReady = [&]() {
+            while (!core.pending.empty() && core.pending.top().first <= core.currentTime) {
+                core.readyQueue.push_back(core.pending.top().second);
+                core.pending.pop();
+            }
+        };
+
+        while (core.currentTime < windowEnd) {
+            admitReady();
+            if (core.readyQueue.empty()) {
+                // Idle until the next placed process becomes ready or the window closes
+                if (core.pending.empty() || core.pending.top().first >= windowEnd) {
+                    core.currentTime = windowEnd;
+                    break;
+                }
+                core.currentTime = core.pending.top().first;
+                continue;
+            }
+
+            int index = core.readyQueue.front();
+            core.readyQueue.pop_front();
+
+            // A slice may run past the window end; the core simply resumes later in the next window
+            int executionTime = std::min(config.timeQuantum, remainingTime[index]);
+            remainingTime[index] -= executionTime;
+            core.currentTime += executionTime;
+            core.busyTime += executionTime;
+            core.queuedWork -= executionTime;
+
+            if (remainingTime[index] > 0) {
+                core.readyQueue.push_back(index);
+            } else {
+                completionTime[index] = core.currentTime;
+                core.completed++;
+            }
+        }
+    }
+
+    // Idle cores steal half of the longest run queue, taking from its back like a work-stealing deque
+    void stealWork(long long windowStart) {
+        for (auto& thief : cores) {
+            if (!thief.readyQueue.empty() || !thief.pending.empty()) {
+                continue;
+            }
+            auto victim = std::max_element(cores.begin(), cores.end(), [](const Core& a, const Core& b) {
+                return a.readyQueue.size() < b.readyQueue.size();
+            });
+            size_t stealCount = victim->readyQueue.size() / 2;
+            for (size_t i = 0; i < stealCount; ++i) {
+                int index = victim->readyQueue.back();
+                victim->readyQueue.pop_back();
+                victim->queuedWork -= remainingTime[index];
+                thief.queuedWork += remainingTime[index];
+                thief.pending.push({windowStart + config.migrationCost, index});
+                thief.migrationsIn++;
+            }
+        }
+    }
+
+public:
+    MultiCoreSimulator(const MultiCoreConfig& cfg) : config(cfg) {
+        if (config.cores <= 0 || config.timeQuantum <= 0 || config.balanceInterval <= 0 || config.migrationCost < 0) {
+            throw std::invalid_argument("Invalid multi-core configuration");
+        }
+        if (config.threads <= 0) {
+            config.threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        config.threads = std::min(config.threads, config.cores);
+    }
+
+    const std::vector<Core>& getCores() const { return cores; }
+
+    ScheduleResult run(const ProcessTable& table) {
+        size_t n = table.size();
+        cores.assign(config.cores, Core());
+        remainingTime = table.burstTime;
+        completionTime.assign(n, 0);
+
+        std::vector<int> arrivalOrder(n);
+        std::iota(arrivalOrder.begin(), arrivalOrder.end(), 0);
+        std::stable_sort(arrivalOrder.begin(), arrivalOrder.end(), [&table](int a, int b) {
+            return table.arrivalTime[a] < table.arrivalTime[b];
+        });
+
+        size_t nextArrival = 0;
+        long long windowStart = 0;
+        bool finished = n == 0;
+
+        // Worker w drives cores w, w + threads, w + 2 * threads, ...
+        Barrier windowStarted(config.threads + 1);
+        Barrier windowDone(config.threads + 1);
+        std::vector<std::thread> workers;
+        for (int w = 0; w < config.threads; ++w) {
+            workers.emplace_back([&, w]() {
+                while (true) {
+                    windowStarted.wait();
+                    if (finished) {
+                        return;
+                    }
+                    for (int c = w; c < config.cores; c += config.threads) {
+                        runCoreUntil(cores[c], windowStart + config.balanceInterval);
+                    }
+                    windowDone.wait();
+                }
+            });
+        }
+
+        // Least loaded core first
+        auto moreLoaded = [this](int a, int b) { return cores[a].queuedWork > cores[b].queuedWork; };
+
+        while (!finished) {
+            long long windowEnd = windowStart + config.balanceInterval;
+
+            // Place the arrivals of this window on the least loaded cores
+            std::priority_queue<int, std::vector<int>, decltype(moreLoaded)> leastLoaded(moreLoaded);
+            for (int c = 0; c < config.cores; ++c) {
+                leastLoaded.push(c);
+            }
+            while (nextArrival < n && table.arrivalTime[arrivalOrder[nextArrival]] < windowEnd) {
+                int index = arrivalOrder[nextArrival++];
+                int c = leastLoaded.top();
+                leastLoaded.pop();
+                cores[c].pending.push({table.arrivalTime[index], index});
+                cores[c].queuedWork += table.burstTime[index];
+                leastLoaded.push(c);
+            }
+            stealWork(windowStart);
+
+            windowStarted.wait();
+            windowDone.wait();
+
+            size_t completed = 0;
+            bool allIdle = true;
+            for (const auto& core : cores) {
+                completed += core.completed;
+                allIdle = allIdle && core.readyQueue.empty() && core.pending.empty();
+            }
+            finished = completed == n;
+
+            windowStart = windowEnd;
+            if (!finished && allIdle && nextArrival < n) {
+                // Nothing is running anywhere: skip straight to the window holding the next arrival
+                long long arrival = table.arrivalTime[arrivalOrder[nextArrival]];
+                windowStart = std::max(windowStart, arrival - arrival % config.balanceInterval);
+                for (auto& core : cores) {
+                    core.currentTime = std::max(core.currentTime, windowStart);
+                }
+            }
+        }
+
+        windowStarted.wait();  // Releases the workers so they see finished
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        makespan = n ? *std::max_element(completionTime.begin(), completionTime.end()) : 0;
+
+        ScheduleResult result;
+        result.waitingTime.resize(n);
+        result.turnaroundTime.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            result.turnaroundTime[i] = completionTime[i] - table.arrivalTime[i];
+            result.waitingTime[i] = result.turnaroundTime[i] - table.burstTime[i];
+        }
+        return result;
+    }
+
+    void displayCoreStats() const {
+        std::cout << "Core\tBusy\tUtilization\tCompleted\tThroughput\tMigrations\n";
+        for (size_t c = 0; c < cores.size(); ++c) {
+            const Core& core = cores[c];
+            std::cout << c << "\t"
+                      << core.busyTime << "\t"
+                      << (makespan ? static_cast<double>(core.busyTime) / makespan : 0.0) << "\t\t"
+                      << core.completed << "\t\t"
+                      << (makespan ? static_cast<double>(core.completed) / makespan : 0.0) << "\t\t"
+                      << core.migrationsIn << "\n";
+        }
+        std::cout << "Makespan: " << makespan << "\n";
+    }
+};
+
+// Usage: MultiCore [cores [workload.csv|workload.bin]]
+int main(int argc, char* argv[]) {
+    MultiCoreConfig config;
+
+    try {
+        if (argc > 1) {
+            config.cores = std::stoi(argv[1]);
+        }
+
+        ProcessTable table;
+        if (argc > 2) {
+            table = loadProcessTable(argv[2]);
+        } else {
+            // Synthetic workload: (id, arrival time, burst time), mostly short jobs with a few long ones
+            std::mt19937 generator(42);
+            std::uniform_int_distribution<int> gap(0, 2);
+            std::uniform_int_distribution<int> shortBurst(1, 10);
+            std::uniform_int_distribution<int> longBurst(50, 500);
+            int arrival = 0;
+            for (int id = 1; id <= 200000; ++id) {
+                arrival += gap(generator);
+                table.addProcess(id, arrival, id % 20 == 0 ? longBurst(generator) : shortBurst(generator));
+            }
+        }
+
+        MultiCoreSimulator simulator(config);
+        auto start = std::chrono::steady_clock::now();
+        ScheduleResult result = simulator.run(table);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        simulator.displayCoreStats();
+        std::cout << "\n";
+        displayAverages(result);
+        std::cout << "Simulated " << table.size() << " processes on " << config.cores << " cores in "
+                  << elapsed.count() << " seconds\n";
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
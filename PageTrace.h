@@ -0,0 +1,251 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "WorkloadIO.h"
+
+// Address traces come in two formats:
+//   Raw:   packed little-endian uint64 virtual addresses, no header
+//   Delta: the 8-byte magic "PGDELTA1", a uint64 record count, then one zigzag LEB128 varint per
+//          access holding the difference from the previous address (the first is relative to 0)
+// Sequential and strided traces shrink to one or two bytes per access in the delta format.
+
+const char DELTA_TRACE_MAGIC[8] = {'P', 'G', 'D', 'E', 'L', 'T', 'A', '1'};
+
+// Gives every distinct page number a dense id 0, 1, 2, ... in order of first use, so the
+// replacement policies see small ints whatever the width of the address space.
+// Open addressing with linear probing; the table doubles at half load.
+class PageNumbering {
+private:
+    struct Slot {
+        uint64_t page;
+        int id;  // -1 when empty
+    };
+
+    std::vector<Slot> slots;
+    uint64_t mask;
+    int shift;
+    int nextId;
+
+    size_t slotOf(uint64_t page) const {
+        return (page * 0x9E3779B97F4A7C15ULL) >> shift;
+    }
+
+    void grow() {
+        std::vector<Slot> old(slots.size() * 2, Slot{0, -1});
+        old.swap(slots);
+        mask = slots.size() - 1;
+        shift--;
+        for (const Slot& slot : old) {
+            if (slot.id >= 0) {
+                size_t s = slotOf(slot.page);
+                while (slots[s].id >= 0) {
+                    s = (s + 1) & mask;
+                }
+                slots[s] = slot;
+            }
+        }
+    }
+
+public:
+    PageNumbering() : slots(1 << 16, Slot{0, -1}), mask((1 << 16) - 1), shift(64 - 16), nextId(0) {}
+
+    int idOf(uint64_t page) {
+        size_t s = slotOf(page);
+        while (slots[s].id >= 0) {
+            if (slots[s].page == page) {
+                return slots[s].id;
+            }
+            s = (s + 1) & mask;
+        }
+        if (static_cast<size_t>(nextId) * 2 >= slots.size()) {
+            grow();
+            return idOf(page);
+        }
+        slots[s] = {page, nextId};
+        return nextId++;
+    }
+
+    // Distinct pages seen so far
+    int size() const { return nextId; }
+};
+
+// Streams a mapped address trace a block at a time, as dense page ids or as raw page numbers
+class PageTraceReader {
+private:
+    MappedFile file;
+    const unsigned char* cursor;
+    const unsigned char* end;
+    bool delta;
+    uint64_t recordCount;
+    uint64_t recordsRead;
+    uint64_t previousAddress;
+    int pageShift;
+    PageNumbering numbering;
+
+    uint64_t nextDelta() {
+        uint64_t value = 0;
+        int bits = 0;
+        while (true) {
+            if (cursor == end || bits > 63) {
+                throw std::runtime_error("Truncated delta trace");
+            }
+            unsigned char byte = *cursor++;
+            value |= static_cast<uint64_t>(byte & 0x7F) << bits;
+            if (!(byte & 0x80)) {
+                break;
+            }
+            bits += 7;
+        }
+        uint64_t difference = (value >> 1) ^ (~(value & 1) + 1);  // Undo zigzag
+        previousAddress += difference;
+        return previousAddress;
+    }
+
+    uint64_t nextAddress() {
+        if (delta) {
+            return nextDelta();
+        }
+        uint64_t address;
+        std::memcpy(&address, cursor, sizeof(address));
+        cursor += sizeof(address);
+        return address;
+    }
+
+public:
+    // pageSize must be a power of two
+    PageTraceReader(const std::string& path, uint64_t pageSize)
+        : file(path), cursor(reinterpret_cast<const unsigned char*>(file.begin())),
+          end(reinterpret_cast<const unsigned char*>(file.end())), delta(false), recordCount(0),
+          recordsRead(0), previousAddress(0), pageShift(0) {
+        if (pageSize == 0 || (pageSize & (pageSize - 1)) != 0) {
+            throw std::invalid_argument("Page size must be a power of two");
+        }
+        while ((uint64_t(1) << pageShift) < pageSize) {
+            pageShift++;
+        }
+        if (file.size() >= sizeof(DELTA_TRACE_MAGIC) && std::memcmp(file.begin(), DELTA_TRACE_MAGIC, sizeof(DELTA_TRACE_MAGIC)) == 0) {
+            delta = true;
+            if (file.size() < sizeof(DELTA_TRACE_MAGIC) + sizeof(recordCount)) {
+                throw std::runtime_error("Truncated trace header in " + path);
+            }
+            std::memcpy(&recordCount, file.begin() + sizeof(DELTA_TRACE_MAGIC), sizeof(recordCount));
+            cursor += sizeof(DELTA_TRACE_MAGIC) + sizeof(recordCount);
+        } else {
+            if (file.size() % sizeof(uint64_t) != 0) {
+                throw std::runtime_error("Raw trace size is not a multiple of 8 bytes in " + path);
+            }
+            recordCount = file.size() / sizeof(uint64_t);
+        }
+    }
+
+    bool isDelta() const { return delta; }
+    uint64_t totalRecords() const { return recordCount; }
+    int distinctPages() const { return numbering.size(); }
+
+    // Fills pages with up to maxCount ids and returns how many were read; 0 at the end of the trace
+    size_t nextBlock(int* pages, size_t maxCount) {
+        size_t count = std::min<uint64_t>(maxCount, recordCount - recordsRead);
+        for (size_t i = 0; i < count; ++i) {
+            pages[i] = numbering.idOf(nextAddress() >> pageShift);
+        }
+        recordsRead += count;
+        return count;
+    }
+
+    // Like nextBlock, but yields the page numbers themselves and never touches the numbering, so
+    // memory stays constant however many distinct pages the trace has (distinctPages stays 0)
+    size_t nextPageNumbers(uint64_t* pages, size_t maxCount) {
+        size_t count = std::min<uint64_t>(maxCount, recordCount - recordsRead);
+        for (size_t i = 0; i < count; ++i) {
+            pages[i] = nextAddress() >> pageShift;
+        }
+        recordsRead += count;
+        return count;
+    }
+};
+
+// Writes addresses in the delta format; the record count is patched into the header on close
+class DeltaTraceWriter {
+private:
+    int fd;
+    std::vector<unsigned char> buffer;
+    size_t used;
+    uint64_t recordCount;
+    uint64_t previousAddress;
+
+    void flush() {
+        size_t written = 0;
+        while (written < used) {
+            ssize_t result = write(fd, buffer.data() + written, used - written);
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;  // Interrupted before anything was written
+                }
+                throw std::runtime_error("Failed to write trace");
+            }
+            written += result;
+        }
+        used = 0;
+    }
+
+public:
+    DeltaTraceWriter(const std::string& path, size_t bufferSize = 1 << 20)
+        : fd(-1), buffer(bufferSize), used(0), recordCount(0), previousAddress(0) {
+        if (bufferSize < sizeof(DELTA_TRACE_MAGIC) + sizeof(recordCount)) {
+            throw std::invalid_argument("Trace buffer must hold at least the header");
+        }
+        fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot create " + path);
+        }
+        std::memcpy(buffer.data(), DELTA_TRACE_MAGIC, sizeof(DELTA_TRACE_MAGIC));
+        std::memset(buffer.data() + sizeof(DELTA_TRACE_MAGIC), 0, sizeof(recordCount));
+        used = sizeof(DELTA_TRACE_MAGIC) + sizeof(recordCount);
+    }
+
+    ~DeltaTraceWriter() {
+        if (fd >= 0) {
+            try {
+                close();
+            } catch (const std::exception&) {
+                // Destructors must not throw; call close() to see write errors
+            }
+        }
+    }
+
+    DeltaTraceWriter(const DeltaTraceWriter&) = delete;
+    DeltaTraceWriter& operator=(const DeltaTraceWriter&) = delete;
+
+    void append(uint64_t address) {
+        if (used + 10 > buffer.size()) {
+            flush();
+        }
+        uint64_t difference = address - previousAddress;
+        uint64_t value = (difference << 1) ^ (~(difference >> 63) + 1);  // Zigzag: small negatives stay small
+        previousAddress = address;
+        while (value >= 0x80) {
+            buffer[used++] = static_cast<unsigned char>(value | 0x80);
+            value >>= 7;
+        }
+        buffer[used++] = static_cast<unsigned char>(value);
+        recordCount++;
+    }
+
+    void close() {
+        flush();
+        if (pwrite(fd, &recordCount, sizeof(recordCount), sizeof(DELTA_TRACE_MAGIC)) != sizeof(recordCount)) {
+            ::close(fd);
+            fd = -1;
+            throw std::runtime_error("Failed to write trace header");
+        }
+        ::close(fd);
+        fd = -1;
+    }
+};
@@ -4,6 +4,17 @@
 #include <queue>
 #include <vector>
 #include <unordered_set>
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include "PageTrace.h"
 
 using namespace std;
 
@@ -13,6 +24,7 @@ protected:
 
 public:
     PageReplacement(int capacity) : capacity(capacity) {}
+    virtual ~PageReplacement() = default;
     virtual bool accessPage(int page) = 0;  // Returns true if page fault occurs
     virtual void displayPages() const = 0;
 };
@@ -49,13 +61,165 @@ public:
     }
 };
 
-// LRU Page Replacement
+// Flat open-addressing map from page number to frame slot, sized once for a fixed number of
+// pages. Linear probing with backward-shift deletion, so erasing leaves no tombstones and
+// nothing is allocated after construction. Page is int for the dense ids the policies see and
+// uint64_t for raw page numbers.
+template <typename Page>
+class BasicFrameIndex {
+    struct Slot {
+        Page page;
+        int frame;  // -1 when empty
+    };
+
+    vector<Slot> slots;
+    unsigned mask;
+    int shift;
+
+    unsigned slotOf(Page page) const {
+        return static_cast<unsigned>((static_cast<uint64_t>(page) * 0x9E3779B97F4A7C15ULL) >> shift);
+    }
+
+public:
+    // Keeps the load factor at or below one half for up to maxPages entries
+    BasicFrameIndex(int maxPages) : mask(0), shift(64) {
+        unsigned size = 2;
+        while (size < 2u * max(maxPages, 1)) {
+            size *= 2;
+        }
+        slots.assign(size, Slot{0, -1});
+        mask = size - 1;
+        while ((uint64_t(1) << (64 - shift)) < size) {
+            shift--;
+        }
+    }
+
+    // Frame holding page, or -1
+    int find(Page page) const {
+        for (unsigned s = slotOf(page);; s = (s + 1) & mask) {
+            if (slots[s].frame < 0) {
+                return -1;
+            }
+            if (slots[s].page == page) {
+                return slots[s].frame;
+            }
+        }
+    }
+
+    void insert(Page page, int frame) {
+        unsigned s = slotOf(page);
+        while (slots[s].frame >= 0) {
+            s = (s + 1) & mask;
+        }
+        slots[s] = {page, frame};
+    }
+
+    void erase(Page page) {
+        unsigned s = slotOf(page);
+        while (slots[s].page != page || slots[s].frame < 0) {
+            if (slots[s].frame < 0) {
+                return;
+            }
+            s = (s + 1) & mask;
+        }
+        // Pull later entries of the probe run back into the hole when their home slot allows it
+        for (unsigned next = (s + 1) & mask; slots[next].frame >= 0; next = (next + 1) & mask) {
+            unsigned home = slotOf(slots[next].page);
+            if (((next - home) & mask) >= ((next - s) & mask)) {
+                slots[s] = slots[next];
+                s = next;
+            }
+        }
+        slots[s].frame = -1;
+    }
+};
+
+using FrameIndex = BasicFrameIndex<int>;
+
+// LRU Page Replacement: frames live in a preallocated array threaded by index-based
+// prev/next links (head is the most recent) and are found through a FrameIndex,
+// so an access is one probe sequence and a few stores with no allocation.
 class LRU : public PageReplacement {
+    struct Frame {
+        int page;
+        int prev;
+        int next;
+    };
+
+    vector<Frame> frames;
+    FrameIndex index;
+    int head;
+    int tail;
+    int used;
+
+    void unlink(int f) {
+        if (frames[f].prev >= 0) {
+            frames[frames[f].prev].next = frames[f].next;
+        } else {
+            head = frames[f].next;
+        }
+        if (frames[f].next >= 0) {
+            frames[frames[f].next].prev = frames[f].prev;
+        } else {
+            tail = frames[f].prev;
+        }
+    }
+
+    void pushFront(int f) {
+        frames[f].prev = -1;
+        frames[f].next = head;
+        if (head >= 0) {
+            frames[head].prev = f;
+        } else {
+            tail = f;
+        }
+        head = f;
+    }
+
+public:
+    LRU(int capacity)
+        : PageReplacement(capacity), frames(max(capacity, 0)), index(capacity), head(-1), tail(-1), used(0) {}
+
+    bool accessPage(int page) override {
+        int f = index.find(page);
+        if (f >= 0) {
+            if (f != head) {
+                unlink(f);
+                pushFront(f);
+            }
+            return false; // No page fault
+        }
+        if (capacity <= 0) {
+            return true;
+        }
+        if (used == capacity) {
+            f = tail; // Reuse the least recent frame
+            index.erase(frames[f].page);
+            unlink(f);
+        } else {
+            f = used++;
+        }
+        frames[f].page = page;
+        index.insert(page, f);
+        pushFront(f);
+        return true; // Page fault occurs
+    }
+
+    void displayPages() const override {
+        for (int f = head; f >= 0; f = frames[f].next) {
+            cout << frames[f].page << " ";
+        }
+        cout << endl;
+    }
+};
+
+// Node-based LRU the array version replaced; kept so --bench can compare the two
+class ListLRU : public PageReplacement {
     list<int> pages;
     unordered_map<int, list<int>::iterator> pageMap;
 
 public:
-    LRU(int capacity) : PageReplacement(capacity) {}
+    ListLRU(int capacity) : PageReplacement(capacity) {}
 
     bool accessPage(int page) override {
         if (pageMap.find(page) != pageMap.end()) {
@@ -82,8 +246,197 @@ public:
     }
 };
 
-// LFU Page Replacement
+// LFU Page Replacement in O(1): frames with the same access count share a frequency bucket and
+// buckets form a list in increasing frequency. Inside a bucket frames are kept most recent first,
+// so the victim is the tail of the lowest bucket (least recent among the least frequent).
+// Frames and buckets come from arrays sized by capacity, so memory never grows with the trace.
+// With a decay interval, every that many accesses all counts are halved so formerly hot pages
+// can age out; that pass is O(capacity) and runs once per interval.
 class LFU : public PageReplacement {
+    struct Frame {
+        int page;
+        int bucket;
+        int prev;
+        int next;
+        long long lastAccess;  // Orders frames when decay merges two buckets
+    };
+
+    struct Bucket {
+        long long frequency;
+        int head;  // Most recent frame
+        int tail;
+        int prev;
+        int next;
+    };
+
+    vector<Frame> frames;
+    vector<Bucket> buckets;  // One per distinct frequency, never more than capacity + 1
+    FrameIndex index;
+    int lowest;              // Bucket with the smallest frequency
+    int freeBucket;
+    int used;
+    long long time;
+    long long decayInterval;
+
+    int newBucket(long long frequency, int prev, int next) {
+        int b = freeBucket;
+        freeBucket = buckets[b].next;
+        buckets[b] = {frequency, -1, -1, prev, next};
+        if (prev >= 0) {
+            buckets[prev].next = b;
+        } else {
+            lowest = b;
+        }
+        if (next >= 0) {
+            buckets[next].prev = b;
+        }
+        return b;
+    }
+
+    void freeBucketIfEmpty(int b) {
+        if (buckets[b].head >= 0) {
+            return;
+        }
+        if (buckets[b].prev >= 0) {
+            buckets[buckets[b].prev].next = buckets[b].next;
+        } else {
+            lowest = buckets[b].next;
+        }
+        if (buckets[b].next >= 0) {
+            buckets[buckets[b].next].prev = buckets[b].prev;
+        }
+        buckets[b].next = freeBucket;
+        freeBucket = b;
+    }
+
+    void unlink(int f) {
+        Bucket& bucket = buckets[frames[f].bucket];
+        if (frames[f].prev >= 0) {
+            frames[frames[f].prev].next = frames[f].next;
+        } else {
+            bucket.head = frames[f].next;
+        }
+        if (frames[f].next >= 0) {
+            frames[frames[f].next].prev = frames[f].prev;
+        } else {
+            bucket.tail = frames[f].prev;
+        }
+    }
+
+    void pushFront(int f, int b) {
+        frames[f].bucket = b;
+        frames[f].prev = -1;
+        frames[f].next = buckets[b].head;
+        if (buckets[b].head >= 0) {
+            frames[buckets[b].head].prev = f;
+        } else {
+            buckets[b].tail = f;
+        }
+        buckets[b].head = f;
+    }
+
+    // Halves every count (never below 1); buckets that land on the same count are merged by recency
+    void decay() {
+        for (int b = lowest; b >= 0;) {
+            int next = buckets[b].next;
+            buckets[b].frequency = max(1LL, buckets[b].frequency / 2);
+            int prev = buckets[b].prev;
+            if (prev >= 0 && buckets[prev].frequency == buckets[b].frequency) {
+                // Merge two recency-ordered lists into prev
+                int a = buckets[prev].head, c = buckets[b].head;
+                int mergedTail = -1;
+                buckets[prev].head = -1;
+                while (a >= 0 || c >= 0) {
+                    int f;
+                    if (c < 0 || (a >= 0 && frames[a].lastAccess > frames[c].lastAccess)) {
+                        f = a;
+                        a = frames[a].next;
+                    } else {
+                        f = c;
+                        c = frames[c].next;
+                    }
+                    frames[f].bucket = prev;
+                    frames[f].prev = mergedTail;
+                    frames[f].next = -1;
+                    if (mergedTail >= 0) {
+                        frames[mergedTail].next = f;
+                    } else {
+                        buckets[prev].head = f;
+                    }
+                    mergedTail = f;
+                }
+                buckets[prev].tail = mergedTail;
+                buckets[b].head = -1;
+                freeBucketIfEmpty(b);
+            }
+            b = next;
+        }
+    }
+
+public:
+    LFU(int capacity, long long decayInterval = 0)
+        : PageReplacement(capacity), frames(max(capacity, 0)), buckets(max(capacity, 0) + 1), index(capacity),
+          lowest(-1), freeBucket(0), used(0), time(0), decayInterval(decayInterval) {
+        for (size_t b = 0; b < buckets.size(); ++b) {
+            buckets[b].next = b + 1 < buckets.size() ? static_cast<int>(b + 1) : -1;
+        }
+    }
+
+    bool accessPage(int page) override {
+        time++;
+        if (decayInterval > 0 && time % decayInterval == 0) {
+            decay();
+        }
+        int f = index.find(page);
+        if (f >= 0) {
+            int b = frames[f].bucket;
+            int next = buckets[b].next;
+            if (next < 0 || buckets[next].frequency != buckets[b].frequency + 1) {
+                next = newBucket(buckets[b].frequency + 1, b, next);
+            }
+            unlink(f);
+            freeBucketIfEmpty(b);
+            pushFront(f, next);
+            frames[f].lastAccess = time;
+            return false; // No page fault
+        }
+        if (capacity <= 0) {
+            return true;
+        }
+        if (used == capacity) {
+            int victimBucket = lowest;
+            f = buckets[victimBucket].tail;
+            index.erase(frames[f].page);
+            unlink(f);
+            freeBucketIfEmpty(victimBucket);
+        } else {
+            f = used++;
+        }
+        int b = lowest;
+        if (b < 0 || buckets[b].frequency != 1) {
+            b = newBucket(1, -1, b);
+        }
+        frames[f].page = page;
+        frames[f].lastAccess = time;
+        index.insert(page, f);
+        pushFront(f, b);
+        return true; // Page fault occurs
+    }
+
+    // Pages from the least to the most frequently used
+    void displayPages() const override {
+        for (int b = lowest; b >= 0; b = buckets[b].next) {
+            for (int f = buckets[b].tail; f >= 0; f = frames[f].prev) {
+                cout << frames[f].page << " ";
+            }
+        }
+        cout << endl;
+    }
+};
+
+// Heap-based LFU the bucket version replaced; it pushes an entry per hit and only drops stale
+// ones at eviction, so its memory grows with the trace. Kept so --bench can compare the two
+class HeapLFU : public PageReplacement {
     struct Page {
         int pageNum;
         int frequency;
@@ -103,7 +456,7 @@ class LFU : public PageReplacement {
     priority_queue<Page, vector<Page>, CompareLFU> minHeap;
 
 public:
-    LFU(int capacity) : PageReplacement(capacity), time(0) {}
+    HeapLFU(int capacity) : PageReplacement(capacity), time(0) {}
 
     bool accessPage(int page) override {
         time++;
@@ -137,8 +490,1181 @@ public:
     }
 };
 
-// Driver code to test the algorithms
-int main() {
+// Several doubly linked page lists sharing one preallocated node pool and one FrameIndex, for
+// policies that move pages between resident and ghost (history-only) lists. Every operation is
+// O(1) and nothing is allocated after construction.
+class PageLists {
+    struct Node {
+        int page;
+        int list;
+        int prev;
+        int next;
+    };
+
+    struct List {
+        int head;  // Most recent
+        int tail;
+        int size;
+    };
+
+    vector<Node> nodes;
+    vector<List> lists;
+    FrameIndex index;
+    int freeNode;
+
+    void unlink(int n) {
+        List& list = lists[nodes[n].list];
+        if (nodes[n].prev >= 0) {
+            nodes[nodes[n].prev].next = nodes[n].next;
+        } else {
+            list.head = nodes[n].next;
+        }
+        if (nodes[n].next >= 0) {
+            nodes[nodes[n].next].prev = nodes[n].prev;
+        } else {
+            list.tail = nodes[n].prev;
+        }
+        list.size--;
+    }
+
+    void linkFront(int n, int list) {
+        nodes[n].list = list;
+        nodes[n].prev = -1;
+        nodes[n].next = lists[list].head;
+        if (lists[list].head >= 0) {
+            nodes[lists[list].head].prev = n;
+        } else {
+            lists[list].tail = n;
+        }
+        lists[list].head = n;
+        lists[list].size++;
+    }
+
+public:
+    // maxPages bounds the pages held across all lists at once
+    PageLists(int listCount, int maxPages)
+        : nodes(max(maxPages, 1)), lists(listCount, List{-1, -1, 0}), index(maxPages), freeNode(0) {
+        for (size_t n = 0; n < nodes.size(); ++n) {
+            nodes[n].next = n + 1 < nodes.size() ? static_cast<int>(n + 1) : -1;
+        }
+    }
+
+    // List holding page, or -1
+    int listOf(int page) const {
+        int n = index.find(page);
+        return n < 0 ? -1 : nodes[n].list;
+    }
+
+    int size(int list) const { return lists[list].size; }
+
+    // Least recent page of a non-empty list
+    int back(int list) const { return nodes[lists[list].tail].page; }
+
+    void pushFront(int list, int page) {
+        int n = freeNode;
+        freeNode = nodes[n].next;
+        nodes[n].page = page;
+        index.insert(page, n);
+        linkFront(n, list);
+    }
+
+    // Moves a page already in some list to the front of list
+    void moveToFront(int page, int list) {
+        int n = index.find(page);
+        unlink(n);
+        linkFront(n, list);
+    }
+
+    void erase(int page) {
+        int n = index.find(page);
+        unlink(n);
+        index.erase(page);
+        nodes[n].next = freeNode;
+        freeNode = n;
+    }
+
+    // Removes and returns the least recent page of a non-empty list
+    int popBack(int list) {
+        int page = back(list);
+        erase(page);
+        return page;
+    }
+
+    void display(int list) const {
+        for (int n = lists[list].head; n >= 0; n = nodes[n].next) {
+            cout << nodes[n].page << " ";
+        }
+    }
+};
+
+// CLOCK Page Replacement: frames sit on a circle with a reference bit each. A hit only sets the
+// bit; on a fault the hand clears set bits as it sweeps and replaces the first unset frame.
+class CLOCK : public PageReplacement {
+    vector<int> pages;
+    vector<char> referenced;
+    FrameIndex index;
+    int hand;
+    int used;
+
+public:
+    CLOCK(int capacity)
+        : PageReplacement(capacity), pages(max(capacity, 0)), referenced(max(capacity, 0)), index(capacity), hand(0), used(0) {}
+
+    bool accessPage(int page) override {
+        int f = index.find(page);
+        if (f >= 0) {
+            referenced[f] = 1;
+            return false; // No page fault
+        }
+        if (capacity <= 0) {
+            return true;
+        }
+        if (used < capacity) {
+            f = used++;
+        } else {
+            while (referenced[hand]) {
+                referenced[hand] = 0;
+                hand = hand + 1 == capacity ? 0 : hand + 1;
+            }
+            f = hand;
+            hand = hand + 1 == capacity ? 0 : hand + 1;
+            index.erase(pages[f]);
+        }
+        pages[f] = page;
+        referenced[f] = 0;
+        index.insert(page, f);
+        return true; // Page fault occurs
+    }
+
+    void displayPages() const override {
+        for (int f = 0; f < used; ++f) {
+            cout << pages[f] << " ";
+        }
+        cout << endl;
+    }
+};
+
+// 2Q Page Replacement (Johnson and Shasha): a page seen once enters the FIFO A1in and is
+// forgotten into the ghost list A1out when it leaves. Only a page faulted again while still
+// remembered in A1out is promoted to the LRU list Am, so a one-off scan never displaces Am.
+class TwoQ : public PageReplacement {
+    enum { A1IN, A1OUT, AM };
+
+    PageLists lists;
+    int inLimit;   // Kin: resident pages A1in may hold before it gives up frames
+    int outLimit;  // Kout: ghost pages remembered in A1out
+
+    // Frees a frame for a new page once every frame is in use
+    void reclaim() {
+        if (lists.size(A1IN) + lists.size(AM) < capacity) {
+            return;
+        }
+        if (lists.size(A1IN) > inLimit || lists.size(AM) == 0) {
+            int page = lists.back(A1IN);
+            lists.moveToFront(page, A1OUT);
+            if (lists.size(A1OUT) > outLimit) {
+                lists.popBack(A1OUT);
+            }
+        } else {
+            lists.popBack(AM);
+        }
+    }
+
+public:
+    TwoQ(int capacity)
+        : PageReplacement(capacity), lists(3, 2 * max(capacity, 1) + 1),
+          inLimit(max(1, capacity / 4)), outLimit(max(1, capacity / 2)) {}
+
+    bool accessPage(int page) override {
+        int list = lists.listOf(page);
+        if (list == AM) {
+            lists.moveToFront(page, AM);
+            return false; // No page fault
+        }
+        if (list == A1IN) {
+            return false; // Correlated reference, A1in stays FIFO
+        }
+        if (capacity <= 0) {
+            return true;
+        }
+        if (list == A1OUT) {
+            lists.erase(page);
+            reclaim();
+            lists.pushFront(AM, page);
+        } else {
+            reclaim();
+            lists.pushFront(A1IN, page);
+        }
+        return true; // Page fault occurs
+    }
+
+    void displayPages() const override {
+        lists.display(A1IN);
+        lists.display(AM);
+        cout << endl;
+    }
+};
+
+// ARC Page Replacement (Megiddo and Modha): T1 holds pages seen once recently, T2 pages seen at
+// least twice, and the ghost lists B1 and B2 remember what each evicted. A fault on a B1 ghost
+// grows the target size p of T1, one on a B2 ghost shrinks it, so the split between recency and
+// frequency adapts to the workload and a scan only churns T1.
+class ARC : public PageReplacement {
+    enum { T1, T2, B1, B2 };
+
+    PageLists lists;
+    int target;  // p: desired size of T1
+
+    // Evicts the LRU page of T1 or T2 into its ghost list, steering |T1| toward target
+    void replace(bool inB2) {
+        int t1 = lists.size(T1);
+        if (t1 > 0 && (t1 > target || (inB2 && t1 == target) || lists.size(T2) == 0)) {
+            lists.moveToFront(lists.back(T1), B1);
+        } else {
+            lists.moveToFront(lists.back(T2), B2);
+        }
+    }
+
+public:
+    ARC(int capacity) : PageReplacement(capacity), lists(4, 2 * max(capacity, 1) + 1), target(0) {}
+
+    bool accessPage(int page) override {
+        int list = lists.listOf(page);
+        if (list == T1 || list == T2) {
+            lists.moveToFront(page, T2);
+            return false; // No page fault
+        }
+        if (capacity <= 0) {
+            return true;
+        }
+        if (list == B1) {
+            target = min(capacity, target + max(lists.size(B2) / lists.size(B1), 1));
+            replace(false);
+            lists.moveToFront(page, T2);
+            return true;
+        }
+        if (list == B2) {
+            target = max(0, target - max(lists.size(B1) / lists.size(B2), 1));
+            replace(true);
+            lists.moveToFront(page, T2);
+            return true;
+        }
+
+        int l1 = lists.size(T1) + lists.size(B1);
+        int total = l1 + lists.size(T2) + lists.size(B2);
+        if (l1 == capacity) {
+            if (lists.size(T1) < capacity) {
+                lists.popBack(B1);
+                replace(false);
+            } else {
+                lists.popBack(T1);
+            }
+        } else if (total >= capacity) {
+            if (total == 2 * capacity) {
+                lists.popBack(B2);
+            }
+            replace(false);
+        }
+        lists.pushFront(T1, page);
+        return true; // Page fault occurs
+    }
+
+    void displayPages() const override {
+        lists.display(T1);
+        lists.display(T2);
+        cout << endl;
+    }
+};
+
+// CLOCK-Pro Page Replacement (Jiang, Chen and Zhang): resident pages are hot or cold, and a cold
+// page evicted during its test period stays behind as a non-resident test entry. A fault on a
+// test entry means the page's reuse distance beats the coldest hot page, so it comes back hot
+// and the cold allocation grows; test entries that expire unused shrink it again.
+// Hot, cold and test pages are kept on separate clocks (the hand is the back of each list and
+// passing a page rotates it to the front), so every hand step pays for one hit or one fault and
+// an access is O(1) amortized. Test periods end when an entry ages off the bounded test clock.
+class CLOCKPro : public PageReplacement {
+    enum { HOT, COLD, TEST, LIST_COUNT };
+
+    struct Entry {
+        int page;
+        char list;
+        bool referenced;
+        bool inTest;  // Cold resident page still in its test period
+        int prev;
+        int next;
+    };
+
+    struct List {
+        int head;
+        int tail;  // Where the hand points
+        int size;
+    };
+
+    vector<Entry> entries;
+    List lists[LIST_COUNT];
+    FrameIndex index;
+    int freeEntry;
+    int coldTarget;  // m_c: resident frames the cold clock is allowed; starts at 1 and adapts
+
+    void unlink(int e) {
+        List& list = lists[static_cast<int>(entries[e].list)];
+        if (entries[e].prev >= 0) {
+            entries[entries[e].prev].next = entries[e].next;
+        } else {
+            list.head = entries[e].next;
+        }
+        if (entries[e].next >= 0) {
+            entries[entries[e].next].prev = entries[e].prev;
+        } else {
+            list.tail = entries[e].prev;
+        }
+        list.size--;
+    }
+
+    void linkFront(int e, int list) {
+        entries[e].list = static_cast<char>(list);
+        entries[e].prev = -1;
+        entries[e].next = lists[list].head;
+        if (lists[list].head >= 0) {
+            entries[lists[list].head].prev = e;
+        } else {
+            lists[list].tail = e;
+        }
+        lists[list].head = e;
+        lists[list].size++;
+    }
+
+    void moveToFront(int e, int list) {
+        unlink(e);
+        linkFront(e, list);
+    }
+
+    void release(int e) {
+        unlink(e);
+        index.erase(entries[e].page);
+        entries[e].next = freeEntry;
+        freeEntry = e;
+    }
+
+    // Oldest test entry ends its test period without a reuse: cold pages need less room
+    void expireTest() {
+        release(lists[TEST].tail);
+        coldTarget = max(1, coldTarget - 1);
+    }
+
+    // Passes the oldest hot page: a referenced one gets another round, otherwise it turns cold
+    void runHandHot() {
+        int e = lists[HOT].tail;
+        if (entries[e].referenced) {
+            entries[e].referenced = false;
+            moveToFront(e, HOT);
+        } else {
+            entries[e].inTest = false;
+            moveToFront(e, COLD);
+        }
+    }
+
+    // Passes the oldest cold page: a reused one is promoted or given a test period, otherwise its
+    // frame is freed and, if it was under test, it is remembered as a test entry
+    void runHandCold() {
+        if (lists[COLD].size == 0) {
+            runHandHot();
+            return;
+        }
+        int e = lists[COLD].tail;
+        if (entries[e].referenced) {
+            entries[e].referenced = false;
+            if (entries[e].inTest) {
+                moveToFront(e, HOT);
+                balanceHot();
+            } else {
+                entries[e].inTest = true;
+                moveToFront(e, COLD);
+            }
+        } else if (entries[e].inTest) {
+            moveToFront(e, TEST);
+            if (lists[TEST].size > capacity) {
+                expireTest();
+            }
+        } else {
+            release(e);
+        }
+    }
+
+    void balanceHot() {
+        while (lists[HOT].size > capacity - coldTarget) {
+            runHandHot();
+        }
+    }
+
+public:
+    CLOCKPro(int capacity)
+        : PageReplacement(capacity), entries(2 * max(capacity, 1) + 1), index(2 * max(capacity, 1) + 1),
+          freeEntry(0), coldTarget(1) {
+        for (List& list : lists) {
+            list = {-1, -1, 0};
+        }
+        for (size_t e = 0; e < entries.size(); ++e) {
+            entries[e].next = e + 1 < entries.size() ? static_cast<int>(e + 1) : -1;
+        }
+    }
+
+    bool accessPage(int page) override {
+        int e = index.find(page);
+        if (e >= 0 && entries[e].list != TEST) {
+            entries[e].referenced = true;
+            return false; // No page fault
+        }
+        if (capacity <= 0) {
+            return true;
+        }
+        int list = COLD;
+        if (e >= 0) {
+            // Faulted during its test period: it comes back hot and cold pages deserve more room
+            coldTarget = min(capacity, coldTarget + 1);
+            release(e);
+            list = HOT;
+        }
+        while (lists[HOT].size + lists[COLD].size >= capacity) {
+            runHandCold();
+        }
+        e = freeEntry;
+        freeEntry = entries[e].next;
+        entries[e].page = page;
+        entries[e].referenced = false;
+        entries[e].inTest = true;
+        index.insert(page, e);
+        linkFront(e, list);
+        if (list == HOT) {
+            balanceHot();
+        }
+        return true; // Page fault occurs
+    }
+
+    void displayPages() const override {
+        for (int list : {HOT, COLD}) {
+            for (int e = lists[list].head; e >= 0; e = entries[e].next) {
+                cout << entries[e].page << " ";
+            }
+        }
+        cout << endl;
+    }
+};
+
+// How far ahead each access's page is used next, as 32-bit gaps in an unlinked scratch file, so a
+// long trace costs 4 bytes per access of disk-backed pages the kernel can write out rather than
+// resident memory. Built in one forward pass: each access fills in the gap of the previous access
+// to the same page. A gap of 0 means never used again; reuses more than 2^32 - 1 accesses apart are
+// stored as 0 too, so OPT treats them as never coming back.
+class NextUseGaps {
+private:
+    int fd;
+    uint32_t* gaps;
+    uint64_t length;
+    uint64_t recorded;
+    vector<uint64_t> lastUse;  // Position + 1 of each page's latest access, 0 if unseen
+
+public:
+    NextUseGaps(uint64_t length) : fd(-1), gaps(nullptr), length(length), recorded(0) {
+        if (length == 0) {
+            return;
+        }
+        const char* directory = getenv("TMPDIR");
+        string path = string(directory ? directory : "/tmp") + "/opt-next-use-XXXXXX";
+        fd = mkstemp(&path[0]);
+        if (fd < 0) {
+            throw runtime_error("Cannot create a scratch file in " + path.substr(0, path.rfind('/')));
+        }
+        unlink(path.c_str());  // Space is released when the descriptor closes
+        size_t bytes = length * sizeof(uint32_t);
+        if (ftruncate(fd, bytes) < 0) {
+            ::close(fd);
+            throw runtime_error("Cannot size the OPT scratch file");
+        }
+        void* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            throw runtime_error("Cannot map the OPT scratch file");
+        }
+        gaps = static_cast<uint32_t*>(mapping);  // ftruncate zero-fills: never used again
+    }
+
+    ~NextUseGaps() {
+        if (gaps) {
+            munmap(gaps, length * sizeof(uint32_t));
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    NextUseGaps(const NextUseGaps&) = delete;
+    NextUseGaps& operator=(const NextUseGaps&) = delete;
+
+    // Page numbers must be small non-negative ids, as PageTraceReader produces
+    void append(int page) {
+        if (page < 0) {
+            throw invalid_argument("OPT needs non-negative page numbers");
+        }
+        if (recorded == length) {
+            throw out_of_range("More accesses than the OPT scratch file was sized for");
+        }
+        if (static_cast<size_t>(page) >= lastUse.size()) {
+            lastUse.resize(max<size_t>(page + 1, lastUse.size() * 2), 0);
+        }
+        if (lastUse[page] > 0) {
+            uint64_t gap = recorded - (lastUse[page] - 1);
+            gaps[lastUse[page] - 1] = gap <= UINT32_MAX ? static_cast<uint32_t>(gap) : 0;
+        }
+        lastUse[page] = ++recorded;
+    }
+
+    // Frees the per-page table once every access is in
+    void finish() {
+        vector<uint64_t>().swap(lastUse);
+        if (gaps) {
+            madvise(gaps, length * sizeof(uint32_t), MADV_SEQUENTIAL);  // OPT reads it front to back
+        }
+    }
+
+    uint64_t size() const { return length; }
+    uint32_t gapAt(uint64_t position) const { return gaps[position]; }
+};
+
+// Belady's optimal (MIN) Page Replacement, for offline bounds: knowing the whole reference string,
+// it evicts the resident page whose next use lies furthest ahead, so no policy can fault less.
+// The next uses come from NextUseGaps; residents sit in an indexed max-heap keyed on the position
+// of their next use, making every access O(log capacity).
+// accessPage must be fed exactly the sequence the gaps were built from.
+class OPT : public PageReplacement {
+    unique_ptr<NextUseGaps> nextUse;
+    uint64_t position;
+    FrameIndex index;
+    vector<int> framePage;
+    vector<uint64_t> frameNext;  // Position of each resident's next use, UINT64_MAX if never
+    vector<int> heap;            // Frames, the one used furthest ahead on top
+    vector<int> heapSlot;        // Where each frame sits in heap
+
+    void place(int slot, int f) {
+        heap[slot] = f;
+        heapSlot[f] = slot;
+    }
+
+    void siftUp(int slot) {
+        int f = heap[slot];
+        while (slot > 0 && frameNext[heap[(slot - 1) / 2]] < frameNext[f]) {
+            place(slot, heap[(slot - 1) / 2]);
+            slot = (slot - 1) / 2;
+        }
+        place(slot, f);
+    }
+
+    void siftDown(int slot) {
+        int f = heap[slot];
+        int size = static_cast<int>(heap.size());
+        while (2 * slot + 1 < size) {
+            int child = 2 * slot + 1;
+            if (child + 1 < size && frameNext[heap[child + 1]] > frameNext[heap[child]]) {
+                child++;
+            }
+            if (frameNext[heap[child]] <= frameNext[f]) {
+                break;
+            }
+            place(slot, heap[child]);
+            slot = child;
+        }
+        place(slot, f);
+    }
+
+public:
+    OPT(int capacity, unique_ptr<NextUseGaps> nextUse)
+        : PageReplacement(capacity), nextUse(std::move(nextUse)), position(0), index(capacity),
+          framePage(max(capacity, 0)), frameNext(max(capacity, 0)), heapSlot(max(capacity, 0)) {
+        heap.reserve(max(capacity, 0));
+        this->nextUse->finish();
+    }
+
+    bool accessPage(int page) override {
+        if (position >= nextUse->size()) {
+            throw out_of_range("OPT accessed past the end of its trace");
+        }
+        uint32_t gap = nextUse->gapAt(position);
+        uint64_t next = gap ? position + gap : UINT64_MAX;
+        position++;
+        int f = index.find(page);
+        if (f >= 0) {
+            // Usually the key grows, but an old key truncated to "never" can shrink, so restore the heap both ways
+            frameNext[f] = next;
+            siftUp(heapSlot[f]);
+            siftDown(heapSlot[f]);
+            return false; // No page fault
+        }
+        if (capacity <= 0) {
+            return true;
+        }
+        if (static_cast<int>(heap.size()) < capacity) {
+            f = static_cast<int>(heap.size());
+            framePage[f] = page;
+            frameNext[f] = next;
+            heap.push_back(f);
+            siftUp(f);
+        } else {
+            f = heap[0]; // Used furthest in the future, or never again
+            index.erase(framePage[f]);
+            framePage[f] = page;
+            frameNext[f] = next;
+            siftDown(0);
+        }
+        index.insert(page, f);
+        return true; // Page fault occurs
+    }
+
+    void displayPages() const override {
+        for (int f : heap) {
+            cout << framePage[f] << " ";
+        }
+        cout << endl;
+    }
+};
+
+// Mattson stack distances: the LRU stack distance of an access is one more than the number of
+// distinct pages touched since the previous access to the same page. Each tracked page keeps a
+// mark at the time slot of its latest access in a Fenwick tree, so the distance is a count of the
+// marks after that slot, O(log pages). Slots are renumbered densely whenever they run out,
+// which keeps the tree proportional to the tracked pages rather than to the trace length.
+// Pages are small handles chosen by the caller.
+class StackDistances {
+    vector<int> tree;        // Fenwick tree over time slots, 1-based
+    vector<int> slotOwner;   // Handle whose latest access is at each slot, or -1
+    vector<int> handleSlot;  // Latest slot of each handle, or -1
+    int nextSlot;
+    int live;                // Handles with a mark
+
+    void add(int slot, int delta) {
+        for (int i = slot + 1; i < static_cast<int>(tree.size()); i += i & -i) {
+            tree[i] += delta;
+        }
+    }
+
+    // Marks at slots 0..slot
+    int prefix(int slot) const {
+        int sum = 0;
+        for (int i = slot + 1; i > 0; i -= i & -i) {
+            sum += tree[i];
+        }
+        return sum;
+    }
+
+    // Renumbers the live marks 0..live-1 in time order into a tree twice their number
+    void compact() {
+        int size = max(2 * live, 1024);
+        vector<int> owners;
+        owners.reserve(live);
+        for (int slot = 0; slot < nextSlot; ++slot) {
+            if (slotOwner[slot] >= 0) {
+                owners.push_back(slotOwner[slot]);
+            }
+        }
+        slotOwner.assign(size, -1);
+        tree.assign(size + 1, 0);
+        for (int slot = 0; slot < static_cast<int>(owners.size()); ++slot) {
+            slotOwner[slot] = owners[slot];
+            handleSlot[owners[slot]] = slot;
+            tree[slot + 1] = 1;
+        }
+        for (int i = 1; i <= size; ++i) {  // Linear-time Fenwick build
+            int parent = i + (i & -i);
+            if (parent <= size) {
+                tree[parent] += tree[i];
+            }
+        }
+        nextSlot = static_cast<int>(owners.size());
+    }
+
+public:
+    StackDistances() : nextSlot(0), live(0) { compact(); }
+
+    // Records an access and returns its stack distance, or 0 for the handle's first access
+    uint64_t access(int handle) {
+        if (handle >= static_cast<int>(handleSlot.size())) {
+            handleSlot.resize(max<size_t>(handle + 1, 2 * handleSlot.size()), -1);
+        }
+        uint64_t distance = 0;
+        int slot = handleSlot[handle];
+        if (slot >= 0) {
+            distance = live - prefix(slot) + 1;
+            add(slot, -1);
+            slotOwner[slot] = -1;
+        } else {
+            live++;
+        }
+        if (nextSlot == static_cast<int>(slotOwner.size())) {
+            handleSlot[handle] = -1;
+            compact();
+        }
+        slot = nextSlot++;
+        add(slot, 1);
+        slotOwner[slot] = handle;
+        handleSlot[handle] = slot;
+        return distance;
+    }
+
+    // Drops a handle, as if it had never been accessed
+    void forget(int handle) {
+        int slot = handleSlot[handle];
+        add(slot, -1);
+        slotOwner[slot] = -1;
+        handleSlot[handle] = -1;
+        live--;
+    }
+};
+
+// LRU miss-ratio curve for every capacity from one pass over the trace. Exact mode keeps a
+// histogram of stack distances: LRU with c frames faults on cold accesses and on distances above c.
+// SHARDS mode (Waldspurger et al.) only follows pages whose spatial hash falls under a threshold,
+// so a sample rate R sees about R of the pages; distances and counts are scaled by 1 / R into
+// log-bucketed histogram bins. With a page limit the threshold drops, evicting the pages with the
+// largest hashes, whenever more pages are tracked, so memory stays constant however long the trace.
+// SHARDS hashes the raw page numbers, so it needs no dense numbering of the whole trace.
+class MissRatioCurve {
+    static constexpr int SUB_BUCKET_BITS = 7;
+    static constexpr uint64_t SUB_BUCKETS = 1ULL << SUB_BUCKET_BITS;
+    static constexpr uint64_t HASH_RANGE = 1ULL << 24;  // P: hashes are taken modulo this
+
+    bool sampled;
+    StackDistances stack;
+    uint64_t accesses;
+
+    // Exact mode
+    vector<uint64_t> distanceCounts;  // Index d: accesses at stack distance d, 0 for cold ones
+
+    // SHARDS mode
+    uint64_t threshold;     // T: pages with hash below it are sampled, R = T / P
+    int maxTracked;         // 0 for no limit
+    BasicFrameIndex<uint64_t> handles;  // Sampled page -> StackDistances handle
+    vector<int> freeHandles;
+    priority_queue<pair<uint64_t, uint64_t>> trackedByHash;
+    vector<double> weightedCounts;  // Log-bucketed scaled distances, bin 0 for cold accesses
+    double sampledWeight;
+
+    static uint64_t hashPage(uint64_t page) {
+        uint64_t x = page + 0x9E3779B97F4A7C15ULL;  // splitmix64
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return (x ^ (x >> 31)) % HASH_RANGE;
+    }
+
+    // Values below 2 * SUB_BUCKETS get a bin each; above that each power of two has SUB_BUCKETS bins
+    static int bucketOf(uint64_t distance) {
+        if (distance < 2 * SUB_BUCKETS) {
+            return static_cast<int>(distance);
+        }
+        int highestBit = 63 - __builtin_clzll(distance);
+        int shift = highestBit - SUB_BUCKET_BITS;
+        return static_cast<int>((shift + 1) * SUB_BUCKETS + (distance >> shift) - SUB_BUCKETS);
+    }
+
+    static uint64_t bucketStart(int bucket) {
+        if (bucket < static_cast<int>(2 * SUB_BUCKETS)) {
+            return bucket;
+        }
+        int shift = bucket / SUB_BUCKETS - 1;
+        return (bucket % SUB_BUCKETS + SUB_BUCKETS) << shift;
+    }
+
+    void accessSampled(uint64_t page) {
+        uint64_t hash = hashPage(page);
+        if (hash >= threshold) {
+            return;
+        }
+        double rate = static_cast<double>(threshold) / HASH_RANGE;
+        int handle = handles.find(page);
+        if (handle < 0) {
+            handle = freeHandles.back();
+            freeHandles.pop_back();
+            handles.insert(page, handle);
+            trackedByHash.push({hash, page});
+        }
+        uint64_t distance = stack.access(handle);
+        int bucket = distance == 0 ? 0 : bucketOf(max<uint64_t>(1, static_cast<uint64_t>(distance / rate)));
+        weightedCounts[bucket] += 1.0 / rate;
+        sampledWeight += 1.0 / rate;
+
+        // Over the limit: lower the threshold until the pages with the largest hashes are gone
+        while (maxTracked > 0 && static_cast<int>(trackedByHash.size()) > maxTracked) {
+            threshold = trackedByHash.top().first;
+            while (!trackedByHash.empty() && trackedByHash.top().first >= threshold) {
+                uint64_t evicted = trackedByHash.top().second;
+                trackedByHash.pop();
+                int evictedHandle = handles.find(evicted);
+                stack.forget(evictedHandle);
+                handles.erase(evicted);
+                freeHandles.push_back(evictedHandle);
+            }
+        }
+    }
+
+public:
+    // Exact curve; pages must be small non-negative ids, as PageTraceReader::nextBlock produces
+    MissRatioCurve() : sampled(false), accesses(0), threshold(0), maxTracked(0), handles(0), sampledWeight(0) {
+        distanceCounts.assign(1, 0);
+    }
+
+    // SHARDS estimate at the given starting sample rate, tracking at most maxTracked pages; pages
+    // are raw page numbers, as PageTraceReader::nextPageNumbers produces
+    MissRatioCurve(double rate, int maxTracked)
+        : sampled(true), accesses(0), threshold(static_cast<uint64_t>(rate * HASH_RANGE)), maxTracked(maxTracked),
+          handles(maxTracked + 1), weightedCounts(bucketOf(~0ULL) + 1, 0.0), sampledWeight(0) {
+        if (maxTracked <= 0 || rate <= 0 || rate > 1) {
+            throw invalid_argument("SHARDS needs a sample rate in (0, 1] and a positive page limit");
+        }
+        for (int handle = maxTracked; handle >= 0; --handle) {
+            freeHandles.push_back(handle);
+        }
+    }
+
+    void access(uint64_t page) {
+        accesses++;
+        if (sampled) {
+            accessSampled(page);
+            return;
+        }
+        uint64_t distance = stack.access(static_cast<int>(page));
+        if (distance >= distanceCounts.size()) {
+            distanceCounts.resize(max<size_t>(distance + 1, 2 * distanceCounts.size()), 0);
+        }
+        distanceCounts[distance]++;
+    }
+
+    uint64_t totalAccesses() const { return accesses; }
+
+    // Distinct pages in the trace; in SHARDS mode every page hashing under the current threshold is
+    // still tracked, so their count scaled by 1 / R estimates it
+    double distinctPages() const {
+        if (sampled) {
+            return threshold ? trackedByHash.size() / sampleRate() : 0.0;
+        }
+        return static_cast<double>(distanceCounts[0]);
+    }
+
+    // Current sample rate; 1 in exact mode
+    double sampleRate() const { return sampled ? static_cast<double>(threshold) / HASH_RANGE : 1.0; }
+
+    // Faults (estimated in SHARDS mode) for LRU with each capacity, in increasing order
+    vector<double> faults(const vector<int>& capacities) const {
+        vector<double> result;
+        if (!sampled) {
+            uint64_t hits = 0;
+            size_t d = 1;
+            for (int capacity : capacities) {
+                for (; d < distanceCounts.size() && d <= static_cast<size_t>(capacity); ++d) {
+                    hits += distanceCounts[d];
+                }
+                result.push_back(static_cast<double>(accesses - hits));
+            }
+            return result;
+        }
+        double hitWeight = 0;
+        int bucket = 1;
+        for (int capacity : capacities) {
+            for (; bucket < static_cast<int>(weightedCounts.size()) && bucketStart(bucket) <= static_cast<uint64_t>(capacity); ++bucket) {
+                hitWeight += weightedCounts[bucket];
+            }
+            double missRatio = sampledWeight > 0 ? 1.0 - hitWeight / sampledWeight : 1.0;
+            result.push_back(missRatio * accesses);
+        }
+        return result;
+    }
+};
+
+// Every policy the trace replay runs, constructed fresh for one capacity
+vector<pair<string, unique_ptr<PageReplacement>>> makePolicies(int capacity) {
+    vector<pair<string, unique_ptr<PageReplacement>>> policies;
+    policies.emplace_back("FIFO", make_unique<FIFO>(capacity));
+    policies.emplace_back("LRU", make_unique<LRU>(capacity));
+    policies.emplace_back("LFU", make_unique<LFU>(capacity));
+    policies.emplace_back("LFU-decay", make_unique<LFU>(capacity, 8LL * capacity));
+    policies.emplace_back("CLOCK", make_unique<CLOCK>(capacity));
+    policies.emplace_back("2Q", make_unique<TwoQ>(capacity));
+    policies.emplace_back("ARC", make_unique<ARC>(capacity));
+    policies.emplace_back("CLOCK-Pro", make_unique<CLOCKPro>(capacity));
+    return policies;
+}
+
+// Reusable barrier for the replay workers and the reader
+class Barrier {
+private:
+    mutex barrierMutex;
+    condition_variable allArrived;
+    int expected;
+    int waiting;
+    long long generation;
+
+public:
+    Barrier(int count) : expected(count), waiting(0), generation(0) {}
+
+    void wait() {
+        unique_lock<mutex> lock(barrierMutex);
+        long long arrivedGeneration = generation;
+        if (++waiting == expected) {
+            waiting = 0;
+            generation++;
+            allArrived.notify_all();
+        } else {
+            allArrived.wait(lock, [&] { return generation != arrivedGeneration; });
+        }
+    }
+};
+
+// Replays a mapped address trace through every policy in a single pass. The reader decodes the
+// next block of page ids while the workers feed the current one to their policies (worker w owns
+// policies w, w + threads, ...), so the trace is read once however many policies run.
+// With withOPT, an extra streaming pass first builds OPT's next-use gaps in a scratch file.
+void replayTrace(const string& path, uint64_t pageSize, int capacity, int threads, bool withOPT) {
+    const size_t BLOCK_SIZE = 1 << 16;
+
+    PageTraceReader reader(path, pageSize);
+    auto policies = makePolicies(capacity);
+    chrono::duration<double> optTime(0);
+    if (withOPT) {
+        auto optStart = chrono::steady_clock::now();
+        PageTraceReader preReader(path, pageSize);
+        auto nextUse = make_unique<NextUseGaps>(preReader.totalRecords());
+        vector<int> block(BLOCK_SIZE);
+        while (size_t length = preReader.nextBlock(block.data(), BLOCK_SIZE)) {
+            for (size_t i = 0; i < length; ++i) {
+                nextUse->append(block[i]);
+            }
+        }
+        policies.emplace_back("OPT", make_unique<OPT>(capacity, std::move(nextUse)));
+        optTime = chrono::steady_clock::now() - optStart;
+    }
+    int policyCount = static_cast<int>(policies.size());
+    if (threads <= 0) {
+        threads = max(1u, thread::hardware_concurrency());
+    }
+    threads = min(threads, policyCount);
+
+    vector<uint64_t> faults(policyCount, 0);
+    vector<double> seconds(policyCount, 0.0);
+    vector<int> blocks[2] = {vector<int>(BLOCK_SIZE), vector<int>(BLOCK_SIZE)};
+    size_t blockLength[2] = {0, 0};
+    int current = 0;
+    bool finished = false;
+
+    Barrier blockStarted(threads + 1);
+    Barrier blockDone(threads + 1);
+    vector<thread> workers;
+    for (int w = 0; w < threads; ++w) {
+        workers.emplace_back([&, w]() {
+            while (true) {
+                blockStarted.wait();
+                if (finished) {
+                    return;
+                }
+                const int* pages = blocks[current].data();
+                size_t length = blockLength[current];
+                for (int p = w; p < policyCount; p += threads) {
+                    PageReplacement& policy = *policies[p].second;
+                    uint64_t policyFaults = 0;
+                    auto start = chrono::steady_clock::now();
+                    for (size_t i = 0; i < length; ++i) {
+                        policyFaults += policy.accessPage(pages[i]);
+                    }
+                    seconds[p] += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                    faults[p] += policyFaults;
+                }
+                blockDone.wait();
+            }
+        });
+    }
+
+    auto replayStart = chrono::steady_clock::now();
+    uint64_t accesses = 0;
+    blockLength[current] = reader.nextBlock(blocks[current].data(), BLOCK_SIZE);
+    while (blockLength[current] > 0) {
+        accesses += blockLength[current];
+        blockStarted.wait();
+        int next = current ^ 1;
+        blockLength[next] = reader.nextBlock(blocks[next].data(), BLOCK_SIZE);
+        blockDone.wait();
+        current = next;
+    }
+    finished = true;
+    blockStarted.wait();  // Releases the workers so they see finished
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    chrono::duration<double> replayTime = chrono::steady_clock::now() - replayStart;
+
+    cout << accesses << " accesses, " << reader.distinctPages() << " distinct pages of " << pageSize
+         << " bytes, " << capacity << " frames, " << threads << " threads, " << replayTime.count() << " seconds";
+    if (withOPT) {
+        cout << " (OPT next-use pass " << optTime.count() << " seconds)";
+    }
+    cout << "\n";
+    uint64_t optFaults = withOPT ? faults[policyCount - 1] : 0;
+    cout << "Policy\tFaults\t\tHit ratio\tAccesses/sec" << (withOPT ? "\tFaults / OPT" : "") << "\n";
+    for (int p = 0; p < policyCount; ++p) {
+        double hitRatio = accesses ? 1.0 - static_cast<double>(faults[p]) / accesses : 0.0;
+        cout << policies[p].first << "\t" << faults[p] << "\t\t" << hitRatio << "\t"
+             << (seconds[p] > 0 ? accesses / seconds[p] : 0.0);
+        if (withOPT) {
+            cout << "\t" << (optFaults ? static_cast<double>(faults[p]) / optFaults : 1.0);
+        }
+        cout << "\n";
+    }
+}
+
+// Prints LRU faults and miss ratio at every power-of-two capacity up to the number of distinct
+// pages, from one pass over a mapped trace; a sample rate below 1 switches to SHARDS, which reads
+// raw page numbers and estimates the distinct page count from its sample
+void printMissRatioCurve(const string& path, uint64_t pageSize, double sampleRate, int maxTracked) {
+    const size_t BLOCK_SIZE = 1 << 16;
+
+    PageTraceReader reader(path, pageSize);
+    bool sampled = sampleRate < 1.0;
+    MissRatioCurve curve = sampled ? MissRatioCurve(sampleRate, maxTracked) : MissRatioCurve();
+    auto start = chrono::steady_clock::now();
+    if (sampled) {
+        vector<uint64_t> block(BLOCK_SIZE);
+        while (size_t length = reader.nextPageNumbers(block.data(), BLOCK_SIZE)) {
+            for (size_t i = 0; i < length; ++i) {
+                curve.access(block[i]);
+            }
+        }
+    } else {
+        vector<int> block(BLOCK_SIZE);
+        while (size_t length = reader.nextBlock(block.data(), BLOCK_SIZE)) {
+            for (size_t i = 0; i < length; ++i) {
+                curve.access(block[i]);
+            }
+        }
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    int distinctPages = static_cast<int>(min(curve.distinctPages() + 0.5, double(INT_MAX)));
+    vector<int> capacities;
+    for (int capacity = 1; capacity < distinctPages; capacity *= 2) {
+        capacities.push_back(capacity);
+    }
+    capacities.push_back(max(distinctPages, 1));
+    vector<double> faults = curve.faults(capacities);
+
+    cout << curve.totalAccesses() << " accesses, " << (sampled ? "about " : "") << distinctPages << " distinct pages, "
+         << (sampled ? "SHARDS at final sample rate " + to_string(curve.sampleRate()) : string("exact"))
+         << ", " << elapsed.count() << " seconds\n";
+    cout << "Frames\t\tFaults\t\tMiss ratio\n";
+    for (size_t c = 0; c < capacities.size(); ++c) {
+        double missRatio = curve.totalAccesses() ? faults[c] / curve.totalAccesses() : 0.0;
+        cout << capacities[c] << "\t\t" << static_cast<uint64_t>(faults[c] + 0.5) << "\t\t" << missRatio << "\n";
+    }
+}
+
+// Times the LRU and LFU implementations against the versions they replaced on the same in-memory
+// skewed page stream at several capacities
+void runBenchmark() {
+    const size_t ACCESSES = 20000000;
+    mt19937_64 rng(7);
+    uniform_real_distribution<double> unit(0.0, 1.0);
+    vector<int> pages(ACCESSES);
+    for (int& page : pages) {
+        page = static_cast<int>(1000000 * unit(rng) * unit(rng) * unit(rng));
+    }
+
+    auto accessesPerSecond = [&](PageReplacement& policy, uint64_t& faults) {
+        faults = 0;
+        auto start = chrono::steady_clock::now();
+        for (int page : pages) {
+            faults += policy.accessPage(page);
+        }
+        return ACCESSES / chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    };
+
+    auto compare = [&](const string& name, PageReplacement& before, PageReplacement& after, int capacity) {
+        uint64_t beforeFaults, afterFaults;
+        double beforeRate = accessesPerSecond(before, beforeFaults);
+        double afterRate = accessesPerSecond(after, afterFaults);
+        if (beforeFaults != afterFaults) {
+            throw runtime_error(name + " implementations disagree on the fault count");
+        }
+        cout << name << "\t" << capacity << "\t\t" << afterFaults << "\t" << beforeRate << "\t" << afterRate << "\n";
+    };
+
+    cout << "Policy\tCapacity\tFaults\t\tBefore (acc/s)\tAfter (acc/s)\n";
+    for (int capacity = 1000; capacity <= 1000000; capacity *= 10) {
+        ListLRU listLRU(capacity);
+        LRU arrayLRU(capacity);
+        compare("LRU", listLRU, arrayLRU, capacity);
+        HeapLFU heapLFU(capacity);
+        LFU bucketLFU(capacity);
+        compare("LFU", heapLFU, bucketLFU, capacity);
+    }
+}
+
+// Writes a synthetic delta trace: a skewed working set of hot pages interrupted by long
+// sequential scans over cold memory, the pattern batch jobs produce
+void makeTrace(const string& path, uint64_t accesses, uint64_t pageSize) {
+    const uint64_t HOT_PAGES = 4096;
+    const uint64_t SCAN_EVERY = 200000;
+    const uint64_t SCAN_LENGTH = 20000;
+
+    mt19937_64 rng(42);
+    uniform_real_distribution<double> unit(0.0, 1.0);
+    DeltaTraceWriter writer(path);
+    uint64_t scanPage = 1 << 20;
+    for (uint64_t i = 0; i < accesses; ++i) {
+        uint64_t page;
+        if (i % SCAN_EVERY < SCAN_LENGTH) {
+            page = scanPage++;
+        } else {
+            page = static_cast<uint64_t>(HOT_PAGES * unit(rng) * unit(rng));  // Low pages are hottest
+        }
+        writer.append(page * pageSize + (rng() % pageSize));
+    }
+    writer.close();
+}
+
+// Usage: Page_Replacement [--bench | --trace trace [capacity [pageSize [threads]]] [--opt] |
+//                          --mrc trace [pageSize [sampleRate [maxPages]]] | --make-trace trace accesses [pageSize]]
+// A --mrc sample rate below 1 estimates the curve with SHARDS. A small maxPages lowers the rate
+// further and biases the estimate: on the --make-trace trace, "0.01 512" gave a tail miss ratio
+// anywhere from 0.065 to 0.230 across hash seeds against an exact 0.101.
+int main(int argc, char* argv[]) {
+    try {
+        if (argc > 1 && string(argv[1]) == "--bench") {
+            runBenchmark();
+            return 0;
+        }
+        if (argc > 2 && string(argv[1]) == "--trace") {
+            // --opt, if given, is the last argument
+            bool withOPT = string(argv[argc - 1]) == "--opt";
+            int last = withOPT ? argc - 1 : argc;
+            int capacity = last > 3 ? stoi(argv[3]) : 1024;
+            uint64_t pageSize = last > 4 ? stoull(argv[4]) : 4096;
+            int threads = last > 5 ? stoi(argv[5]) : 0;
+            replayTrace(argv[2], pageSize, capacity, threads, withOPT);
+            return 0;
+        }
+        if (argc > 2 && string(argv[1]) == "--mrc") {
+            uint64_t pageSize = argc > 3 ? stoull(argv[3]) : 4096;
+            double sampleRate = argc > 4 ? stod(argv[4]) : 1.0;
+            int maxTracked = argc > 5 ? stoi(argv[5]) : 8192;
+            printMissRatioCurve(argv[2], pageSize, sampleRate, maxTracked);
+            return 0;
+        }
+        if (argc > 3 && string(argv[1]) == "--make-trace") {
+            makeTrace(argv[2], stoull(argv[3]), argc > 4 ? stoull(argv[4]) : 4096);
+            return 0;
+        }
+    }
+    catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+
+    // Driver code to test the algorithms
     int capacity = 3;
     vector<int> pageRequests = {1, 2, 3, 2, 1, 4, 5, 3, 2, 1, 4, 5};
 
@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SchedulingEngine.h"
+
+// One point of the sweep grid
+struct SweepConfig {
+    std::string policy;
+    int timeQuantum;  // 0 for policies without a quantum
+    size_t workload;
+    std::function<SchedulingStats(const ProcessTable&)> run;
+};
+
+struct SweepResult {
+    double averageWaitingTime;
+    long long p99WaitingTime;
+    double averageTurnaroundTime;
+    long long p99TurnaroundTime;
+};
+
+SweepResult summarize(const SchedulingStats& stats) {
+    return {stats.waiting.mean(), stats.waiting.percentile(0.99),
+            stats.turnaround.mean(), stats.turnaround.percentile(0.99)};
+}
+
+template <typename Policy>
+void addConfig(std::vector<SweepConfig>& grid, Policy policy, int timeQuantum, size_t workload) {
+    grid.push_back({Policy::name, timeQuantum, workload, [policy](const ProcessTable& table) {
+        return SchedulingEngine<Policy>(policy).collectStats(table);
+    }});
+}
+
+// Runs every configuration on a pool of worker threads. Workloads are loaded once and only read,
+// so all workers share them without copying; each run streams into its own fixed-size histograms.
+std::vector<SweepResult> runSweep(const std::vector<SweepConfig>& grid, const std::vector<ProcessTable>& workloads, int threads) {
+    std::vector<SweepResult> results(grid.size());
+    std::atomic<size_t> nextConfig(0);
+
+    std::vector<std::thread> workers;
+    for (int w = 0; w < threads; ++w) {
+        workers.emplace_back([&]() {
+            for (size_t i = nextConfig++; i < grid.size(); i = nextConfig++) {
+                results[i] = summarize(grid[i].run(workloads[grid[i].workload]));
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    return results;
+}
+
+ProcessTable syntheticWorkload(unsigned seed, int processCount, int maxGap) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<int> gap(0, maxGap);
+    std::uniform_int_distribution<int> burst(1, 20);
+    std::uniform_int_distribution<int> priority(0, 9);
+
+    ProcessTable table;
+    table.reserve(processCount);
+    int arrival = 0;
+    for (int id = 1; id <= processCount; ++id) {
+        arrival += gap(generator);
+        table.addProcess(id, arrival, burst(generator), priority(generator));
+    }
+    return table;
+}
+
+// Usage: ParameterSweep [threads [workload.csv|workload.bin ...]]
+int main(int argc, char* argv[]) {
+    try {
+        int threads = argc > 1 ? std::stoi(argv[1]) : 0;
+        if (threads <= 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        std::vector<std::string> workloadNames;
+        std::vector<ProcessTable> workloads;
+        for (int i = 2; i < argc; ++i) {
+            workloadNames.push_back(argv[i]);
+            workloads.push_back(loadProcessTable(argv[i]));
+        }
+        if (workloads.empty()) {
+            // Lightly and heavily loaded synthetic workloads (mean burst 10.5, mean gap 20 and 10)
+            workloadNames = {"light", "heavy"};
+            workloads.push_back(syntheticWorkload(1, 20000, 40));
+            workloads.push_back(syntheticWorkload(2, 20000, 20));
+        }
+
+        std::vector<SweepConfig> grid;
+        for (size_t w = 0; w < workloads.size(); ++w) {
+            addConfig(grid, FCFSPolicy(), 0, w);
+            addConfig(grid, SJFPolicy(), 0, w);
+            addConfig(grid, SRTFPolicy(), 0, w);
+            addConfig(grid, PriorityPolicy(), 0, w);
+            for (int quantum = 1; quantum <= 100; ++quantum) {
+                addConfig(grid, RoundRobinPolicy(quantum), quantum, w);
+                addConfig(grid, MLFQPolicy({quantum, 2 * quantum, 4 * quantum}, 1000), quantum, w);
+            }
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<SweepResult> results = runSweep(grid, workloads, threads);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        std::cout << "Policy\tQuantum\tWorkload\tAvgWait\tP99Wait\tAvgTurnaround\tP99Turnaround\n";
+        std::cout << std::fixed << std::setprecision(2);
+        for (size_t i = 0; i < grid.size(); ++i) {
+            std::cout << grid[i].policy << "\t"
+                      << grid[i].timeQuantum << "\t"
+                      << workloadNames[grid[i].workload] << "\t\t"
+                      << results[i].averageWaitingTime << "\t"
+                      << results[i].p99WaitingTime << "\t"
+                      << results[i].averageTurnaroundTime << "\t\t"
+                      << results[i].p99TurnaroundTime << "\n";
+        }
+        std::cout << "\nSwept " << grid.size() << " configurations on " << threads << " threads in "
+                  << elapsed.count() << " seconds\n";
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -1,144 +1,46 @@
+#include <chrono>
 #include <iostream>
-#include <queue>
-#include <vector>
-#include <algorithm>
-
-class Process {
-private:
-    int id;
-    int arrivalTime;
-    int burstTime;
-    int remainingTime;
-    int waitingTime;
-    int turnaroundTime;
-
-public:
-    Process(int id, int arrivalTime, int burstTime)
-        : id(id), arrivalTime(arrivalTime), burstTime(burstTime), remainingTime(burstTime), waitingTime(0), turnaroundTime(0) {}
-
-    int getId() const { return id; }
-    int getArrivalTime() const { return arrivalTime; }
-    int getBurstTime() const { return burstTime; }
-    int getRemainingTime() const { return remainingTime; }
-    int getWaitingTime() const { return waitingTime; }
-    int getTurnaroundTime() const { return turnaroundTime; }
-
-    void setRemainingTime(int time) { remainingTime = time; }
-    void addWaitingTime(int time) { waitingTime += time; }
-    void setTurnaroundTime(int time) { turnaroundTime = time; }
-};
-
-class RoundRobinScheduler {
-private:
-    std::vector<Process> processList;
-    int timeQuantum;
-
-public:
-    RoundRobinScheduler(int tq) : timeQuantum(tq) {}
-
-    void addProcess(const Process& process) {
-        processList.push_back(process);
-    }
-
-    void run() {
-        int currentTime = 0;
-        std::queue<int> readyQueue; // Queue stores the index of the process in processList
-        std::vector<bool> processCompleted(processList.size(), false);
-        std::vector<bool> inQueue(processList.size(), false);
-        int completedProcesses = 0;
-
-        // Initially, add processes that have arrived at time 0
-        for (size_t i = 0; i < processList.size(); ++i) {
-            if (processList[i].getArrivalTime() <= currentTime) {
-                readyQueue.push(i);
-                inQueue[i] = true;
-            }
+#include <string>
+#include "SchedulingEngine.h"
+
+// Times the engine's round robin on workloads of growing size to check that cost scales linearly with the number of slices
+void runBenchmark() {
+    const int burstTime = 10;
+    const int timeQuantum = 1;
+
+    std::cout << "Slices\t\tSeconds\t\tSlices/sec\n";
+    for (int processCount = 10000; processCount <= 1000000; processCount *= 10) {
+        ProcessTable table;
+        table.reserve(processCount);
+        for (int i = 0; i < processCount; ++i) {
+            table.addProcess(i + 1, i, burstTime);
         }
 
-        while (completedProcesses < processList.size()) {
-            if (readyQueue.empty()) {
-                // If no process is in the ready queue, move time forward to the next arriving process
-                currentTime++;
-                for (size_t i = 0; i < processList.size(); ++i) {
-                    if (!inQueue[i] && processList[i].getArrivalTime() <= currentTime) {
-                        readyQueue.push(i);
-                        inQueue[i] = true;
-                    }
-                }
-                continue;
-            }
-
-            int processIndex = readyQueue.front();
-            readyQueue.pop();
-
-            Process& currentProcess = processList[processIndex];
-            inQueue[processIndex] = false;
-
-            int executionTime = std::min(timeQuantum, currentProcess.getRemainingTime());
-            currentProcess.setRemainingTime(currentProcess.getRemainingTime() - executionTime);
-            currentTime += executionTime;
+        SchedulingEngine<RoundRobinPolicy> engine{RoundRobinPolicy(timeQuantum)};
+        auto start = std::chrono::steady_clock::now();
+        engine.run(table);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
 
-            // Add waiting time for all processes in the ready queue during this time slice
-            for (size_t i = 0; i < processList.size(); ++i) {
-                if (i != processIndex && inQueue[i] && processList[i].getArrivalTime() <= currentTime) {
-                    processList[i].addWaitingTime(executionTime);
-                }
-            }
-
-            // If process is not yet completed, requeue it; else, mark it as completed
-            if (currentProcess.getRemainingTime() > 0) {
-                readyQueue.push(processIndex);
-                inQueue[processIndex] = true;
-            } else {
-                currentProcess.setTurnaroundTime(currentTime - currentProcess.getArrivalTime());
-                completedProcesses++;
-            }
-
-            // Add new processes arriving during this time slice
-            for (size_t i = 0; i < processList.size(); ++i) {
-                if (!inQueue[i] && !processCompleted[i] && processList[i].getArrivalTime() <= currentTime) {
-                    readyQueue.push(i);
-                    inQueue[i] = true;
-                }
-            }
-        }
+        long long slices = static_cast<long long>(processCount) * (burstTime / timeQuantum);
+        std::cout << slices << "\t\t" << elapsed.count() << "\t\t" << slices / elapsed.count() << "\n";
     }
+}
 
-    void displayResults() const {
-        int totalWaitingTime = 0;
-        int totalTurnaroundTime = 0;
-
-        std::cout << "PID\tArrival\tBurst\tWaiting\tTurnaround\n";
-        for (const auto& process : processList) {
-            std::cout << process.getId() << "\t" 
-                      << process.getArrivalTime() << "\t"
-                      << process.getBurstTime() << "\t"
-                      << process.getWaitingTime() << "\t"
-                      << process.getTurnaroundTime() << "\n";
-
-            totalWaitingTime += process.getWaitingTime();
-            totalTurnaroundTime += process.getTurnaroundTime();
-        }
-
-        int n = processList.size();
-        std::cout << "\nAverage Waiting Time: " << static_cast<float>(totalWaitingTime) / n << "\n";
-        std::cout << "Average Turnaround Time: " << static_cast<float>(totalTurnaroundTime) / n << "\n";
+// Usage: RR --bench | RR [workload.csv|workload.bin [results.csv|results.bin]]
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "--bench") {
+        runBenchmark();
+        return 0;
     }
-};
-
-int main() {
-    int timeQuantum = 2;
-    RoundRobinScheduler scheduler(timeQuantum);
 
     // Add processes: (id, arrival time, burst time)
-    scheduler.addProcess(Process(1, 0, 5));
-    scheduler.addProcess(Process(2, 1, 3));
-    scheduler.addProcess(Process(3, 2, 1));
-    scheduler.addProcess(Process(4, 3, 2));
-    scheduler.addProcess(Process(5, 4, 4));
-
-    scheduler.run();
-    scheduler.displayResults();
+    ProcessTable demo;
+    demo.addProcess(1, 0, 5);
+    demo.addProcess(2, 1, 3);
+    demo.addProcess(3, 2, 1);
+    demo.addProcess(4, 3, 2);
+    demo.addProcess(5, 4, 4);
 
-    return 0;
+    int timeQuantum = 2;
+    return runScheduler(argc, argv, demo, RoundRobinPolicy(timeQuantum));
 }
@@ -0,0 +1,72 @@
+#include <iostream>
+#include <string>
+#include "SchedulingEngine.h"
+
+// "results.csv" becomes "results.FCFS.csv" so every policy gets its own result file
+std::string resultPathFor(const std::string& path, const char* policyName) {
+    size_t dot = path.find_last_of('.');
+    size_t slash = path.find_last_of('/');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return path + "." + policyName;
+    }
+    return path.substr(0, dot) + "." + policyName + path.substr(dot);
+}
+
+template <typename Policy>
+void runPolicy(const ProcessTable& table, Policy policy, bool showRows, const std::string& resultPath) {
+    SchedulingEngine<Policy> engine(policy);
+    std::cout << "Testing " << engine.name() << " scheduling:\n";
+
+    // Per-process rows are only materialized when they are printed or written out; either way the
+    // statistics come from the same simulation
+    SchedulingStats stats;
+    if (showRows || !resultPath.empty()) {
+        ScheduleResult result = engine.run(table, stats);
+        if (showRows) {
+            displayResults(table, result);
+            std::cout << "\n";
+        }
+        if (!resultPath.empty()) {
+            ResultWriter writer(resultPathFor(resultPath, engine.name()));
+            writeResults(table, result, writer);
+            writer.close();
+        }
+    } else {
+        stats = engine.collectStats(table);
+    }
+    stats.display();
+    std::cout << "\n";
+}
+
+// Usage: SchedulingEngine [workload.csv|workload.bin [results.csv|results.bin]]
+int main(int argc, char* argv[]) {
+    ProcessTable table;
+    std::string resultPath = argc > 2 ? argv[2] : "";
+
+    try {
+        if (argc > 1) {
+            table = loadProcessTable(argv[1]);
+        } else {
+            // Add processes: (id, arrival time, burst time, priority)
+            table.addProcess(1, 0, 7, 3);
+            table.addProcess(2, 2, 4, 1);
+            table.addProcess(3, 4, 1, 4);
+            table.addProcess(4, 5, 4, 2);
+        }
+
+        // Every policy runs over the same table with the same accounting; loaded traces only print statistics
+        bool showRows = argc <= 1;
+        runPolicy(table, FCFSPolicy(), showRows, resultPath);
+        runPolicy(table, SJFPolicy(), showRows, resultPath);
+        runPolicy(table, SRTFPolicy(), showRows, resultPath);
+        runPolicy(table, RoundRobinPolicy(2), showRows, resultPath);
+        runPolicy(table, PriorityPolicy(), showRows, resultPath);
+        runPolicy(table, MLFQPolicy({2, 4, 8}, 20), showRows, resultPath);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
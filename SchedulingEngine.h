@@ -0,0 +1,476 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "SchedulingStats.h"
+#include "WorkloadIO.h"
+
+// Struct-of-arrays process table: each attribute lives in its own contiguous array,
+// so the passes over arrival/burst/remaining times are tight loops the compiler can vectorize.
+struct ProcessTable {
+    std::vector<int> id;
+    std::vector<int> arrivalTime;
+    std::vector<int> burstTime;
+    std::vector<int> priority;
+
+    size_t size() const { return id.size(); }
+
+    void reserve(size_t count) {
+        id.reserve(count);
+        arrivalTime.reserve(count);
+        burstTime.reserve(count);
+        priority.reserve(count);
+    }
+
+    void addProcess(int processId, int arrival, int burst, int processPriority = 0) {
+        id.push_back(processId);
+        arrivalTime.push_back(arrival);
+        burstTime.push_back(burst);
+        priority.push_back(processPriority);
+    }
+};
+
+// Streams a CSV or binary trace into a table
+inline ProcessTable loadProcessTable(const std::string& path) {
+    WorkloadReader reader(path);
+    ProcessTable table;
+    table.reserve(reader.expectedRecords());
+    JobRecord record;
+    while (reader.next(record)) {
+        table.addProcess(record.id, record.arrivalTime, record.burstTime, record.priority);
+    }
+    return table;
+}
+
+// Per-run output, kept apart from the table so one loaded workload can feed many runs
+struct ScheduleResult {
+    std::vector<long long> waitingTime;
+    std::vector<long long> turnaroundTime;
+};
+
+// Ready heap shared by the policies that always dispatch the smallest key; ties go to the process added first
+class MinKeyQueue {
+private:
+    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>> heap;
+
+public:
+    void push(int key, int index) { heap.push({key, index}); }
+    bool empty() const { return heap.empty(); }
+
+    int pop() {
+        int index = heap.top().second;
+        heap.pop();
+        return index;
+    }
+};
+
+// A policy owns the ready queue and decides, at compile time, which process runs next and for how long.
+// push() admits an arrival, requeue() takes back a process whose slice ended after running ranFor units,
+// and pop() dispatches at currentTime. preemptive policies are re-consulted at every arrival; the others
+// only when a slice ends.
+struct FCFSPolicy {
+    static constexpr bool preemptive = false;
+    static constexpr const char* name = "FCFS";
+
+    std::queue<int> readyQueue;
+
+    void push(const ProcessTable&, int index, int) { readyQueue.push(index); }
+    void requeue(const ProcessTable& table, int index, int remainingTime, int) { push(table, index, remainingTime); }
+    bool empty() const { return readyQueue.empty(); }
+    int timeSlice(int, int remainingTime) const { return remainingTime; }
+
+    int pop(long long) {
+        int index = readyQueue.front();
+        readyQueue.pop();
+        return index;
+    }
+};
+
+struct SJFPolicy {
+    static constexpr bool preemptive = false;
+    static constexpr const char* name = "SJF";
+
+    MinKeyQueue readyQueue;
+
+    void push(const ProcessTable& table, int index, int) { readyQueue.push(table.burstTime[index], index); }
+    void requeue(const ProcessTable& table, int index, int remainingTime, int) { push(table, index, remainingTime); }
+    bool empty() const { return readyQueue.empty(); }
+    int pop(long long) { return readyQueue.pop(); }
+    int timeSlice(int, int remainingTime) const { return remainingTime; }
+};
+
+// Shortest remaining time first: SJF keyed on what is left, re-evaluated whenever a process arrives
+struct SRTFPolicy {
+    static constexpr bool preemptive = true;
+    static constexpr const char* name = "SRTF";
+
+    MinKeyQueue readyQueue;
+
+    void push(const ProcessTable&, int index, int remainingTime) { readyQueue.push(remainingTime, index); }
+    void requeue(const ProcessTable& table, int index, int remainingTime, int) { push(table, index, remainingTime); }
+    bool empty() const { return readyQueue.empty(); }
+    int pop(long long) { return readyQueue.pop(); }
+    int timeSlice(int, int remainingTime) const { return remainingTime; }
+};
+
+struct RoundRobinPolicy {
+    static constexpr bool preemptive = false;
+    static constexpr const char* name = "RR";
+
+    int timeQuantum;
+    std::queue<int> readyQueue;
+
+    RoundRobinPolicy(int tq = 2) : timeQuantum(tq) {
+        if (timeQuantum <= 0) {
+            throw std::invalid_argument("Round robin quantum must be positive");
+        }
+    }
+
+    void push(const ProcessTable&, int index, int) { readyQueue.push(index); }
+    void requeue(const ProcessTable& table, int index, int remainingTime, int) { push(table, index, remainingTime); }
+    bool empty() const { return readyQueue.empty(); }
+    int timeSlice(int, int remainingTime) const { return std::min(timeQuantum, remainingTime); }
+
+    int pop(long long) {
+        int index = readyQueue.front();
+        readyQueue.pop();
+        return index;
+    }
+};
+
+// Preemptive priority: a lower value means a higher priority. Equal priorities go to the process
+// listed first in the workload, the same tie rule as SJF, whether or not the other one is running.
+struct PriorityPolicy {
+    static constexpr bool preemptive = true;
+    static constexpr const char* name = "Priority";
+
+    MinKeyQueue readyQueue;
+
+    void push(const ProcessTable& table, int index, int) { readyQueue.push(table.priority[index], index); }
+    void requeue(const ProcessTable& table, int index, int remainingTime, int) { push(table, index, remainingTime); }
+    bool empty() const { return readyQueue.empty(); }
+    int pop(long long) { return readyQueue.pop(); }
+    int timeSlice(int, int remainingTime) const { return remainingTime; }
+};
+
+// Multi-level feedback queue: round robin inside each level, strict priority between levels.
+// Arrivals enter level 0, a process that uses its whole quantum drops one level, and every
+// boostInterval time units all levels are moved back to level 0. Like the Linux O(1) scheduler,
+// a bitmap of non-empty levels picks the next level with one count-trailing-zeros, and the levels
+// are intrusive linked lists so a boost splices whole levels instead of touching each process.
+// Because arrivals preempt, a process arriving mid-slice queues ahead of the process whose slice it interrupted.
+struct MLFQPolicy {
+    static constexpr bool preemptive = true;
+    static constexpr const char* name = "MLFQ";
+    static constexpr int MAX_LEVELS = 64;
+
+    std::vector<int> levelQuantum;
+    long long boostInterval;  // 0 disables boosts
+    long long nextBoost;
+
+    uint64_t nonEmptyLevels;
+    std::vector<int> head;
+    std::vector<int> tail;
+    std::vector<int> next;         // Per-process link inside its level
+    std::vector<int> quantumUsed;  // Part of the current quantum already consumed
+    int runningLevel;
+
+    MLFQPolicy(std::vector<int> quanta = {2, 4, 8}, long long boost = 50)
+        : levelQuantum(std::move(quanta)), boostInterval(boost), nextBoost(boost), nonEmptyLevels(0),
+          head(levelQuantum.size(), -1), tail(levelQuantum.size(), -1), runningLevel(0) {
+        if (levelQuantum.empty() || levelQuantum.size() > MAX_LEVELS) {
+            throw std::invalid_argument("MLFQ needs between 1 and 64 levels");
+        }
+        for (int quantum : levelQuantum) {
+            if (quantum <= 0) {
+                throw std::invalid_argument("MLFQ quanta must be positive");
+            }
+        }
+    }
+
+    void pushBack(int level, int index) {
+        next[index] = -1;
+        if (tail[level] == -1) {
+            head[level] = index;
+        } else {
+            next[tail[level]] = index;
+        }
+        tail[level] = index;
+        nonEmptyLevels |= uint64_t(1) << level;
+    }
+
+    void pushFront(int level, int index) {
+        next[index] = head[level];
+        head[level] = index;
+        if (tail[level] == -1) {
+            tail[level] = index;
+        }
+        nonEmptyLevels |= uint64_t(1) << level;
+    }
+
+    // Priority boost: append every lower level to level 0, oldest level first
+    void boost() {
+        for (size_t level = 1; level < levelQuantum.size(); ++level) {
+            if (head[level] == -1) {
+                continue;
+            }
+            if (tail[0] == -1) {
+                head[0] = head[level];
+            } else {
+                next[tail[0]] = head[level];
+            }
+            tail[0] = tail[level];
+            head[level] = tail[level] = -1;
+        }
+        if (nonEmptyLevels) {
+            nonEmptyLevels = 1;
+        }
+    }
+
+    void push(const ProcessTable& table, int index, int) {
+        if (next.empty()) {
+            next.assign(table.size(), -1);
+            quantumUsed.assign(table.size(), 0);
+        }
+        quantumUsed[index] = 0;
+        pushBack(0, index);
+    }
+
+    void requeue(const ProcessTable&, int index, int, int ranFor) {
+        quantumUsed[index] += ranFor;
+        if (quantumUsed[index] >= levelQuantum[runningLevel]) {
+            // Used the whole quantum: demote
+            int level = std::min<int>(runningLevel + 1, levelQuantum.size() - 1);
+            quantumUsed[index] = 0;
+            pushBack(level, index);
+        } else {
+            // Preempted by an arrival: resume at the head of its level with what is left of the quantum
+            pushFront(runningLevel, index);
+        }
+    }
+
+    bool empty() const { return nonEmptyLevels == 0; }
+
+    int pop(long long currentTime) {
+        // Boosts are applied at the first dispatch on or after each boundary
+        if (boostInterval > 0 && currentTime >= nextBoost) {
+            boost();
+            nextBoost = (currentTime / boostInterval + 1) * boostInterval;
+        }
+
+        runningLevel = __builtin_ctzll(nonEmptyLevels);
+        int index = head[runningLevel];
+        head[runningLevel] = next[index];
+        if (head[runningLevel] == -1) {
+            tail[runningLevel] = -1;
+            nonEmptyLevels &= ~(uint64_t(1) << runningLevel);
+        }
+        // A boost can lift a partly served process into a level with a shorter quantum
+        if (quantumUsed[index] >= levelQuantum[runningLevel]) {
+            quantumUsed[index] = 0;
+        }
+        return index;
+    }
+
+    int timeSlice(int index, int remainingTime) const {
+        return std::min(levelQuantum[runningLevel] - quantumUsed[index], remainingTime);
+    }
+};
+
+// Event-driven scheduling engine shared by every policy: time jumps between arrivals and slice ends,
+// and waiting/turnaround are derived once at the end with the same accounting for all policies.
+template <typename Policy>
+class SchedulingEngine {
+private:
+    Policy policy;
+
+    // The one place response, waiting and turnaround times are recorded, for every policy
+    template <typename OnComplete>
+    void simulateWithStats(const ProcessTable& table, SchedulingStats& stats, OnComplete onComplete) const {
+        simulate(table,
+            [&](int index, long long time) { stats.recordResponse(time - table.arrivalTime[index]); },
+            [&](int index, long long time) {
+                onComplete(index, time);
+                long long turnaroundTime = time - table.arrivalTime[index];
+                stats.recordCompletion(turnaroundTime - table.burstTime[index], turnaroundTime);
+            });
+    }
+
+    static ScheduleResult resultFrom(const ProcessTable& table, const std::vector<long long>& completionTime) {
+        size_t n = table.size();
+        ScheduleResult result;
+        result.waitingTime.resize(n);
+        result.turnaroundTime.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            result.turnaroundTime[i] = completionTime[i] - table.arrivalTime[i];
+            result.waitingTime[i] = result.turnaroundTime[i] - table.burstTime[i];
+        }
+        return result;
+    }
+
+public:
+    SchedulingEngine(Policy p = Policy()) : policy(std::move(p)) {}
+
+    const char* name() const { return Policy::name; }
+
+    // Runs the dispatch loop, calling onFirstRun(index, time) when a process is dispatched for the first
+    // time and onComplete(index, time) when it finishes. The table is only read, so several engines
+    // can run over the same workload.
+    template <typename OnFirstRun, typename OnComplete>
+    void simulate(const ProcessTable& table, OnFirstRun onFirstRun, OnComplete onComplete) const {
+        size_t n = table.size();
+        Policy readyQueue = policy;  // Fresh ready queue for this run
+        std::vector<int> remainingTime(table.burstTime);
+        std::vector<bool> started(n, false);
+
+        // Sort arrivals once and sweep them with a cursor; traces that are already sorted skip the sort
+        std::vector<int> arrivalOrder(n);
+        std::iota(arrivalOrder.begin(), arrivalOrder.end(), 0);
+        if (!std::is_sorted(table.arrivalTime.begin(), table.arrivalTime.end())) {
+            std::stable_sort(arrivalOrder.begin(), arrivalOrder.end(), [&table](int a, int b) {
+                return table.arrivalTime[a] < table.arrivalTime[b];
+            });
+        }
+
+        long long currentTime = 0;
+        size_t nextArrival = 0;
+        size_t completedProcesses = 0;
+
+        auto admitArrivals = [&]() {
+            while (nextArrival < n && table.arrivalTime[arrivalOrder[nextArrival]] <= currentTime) {
+                int index = arrivalOrder[nextArrival++];
+                readyQueue.push(table, index, remainingTime[index]);
+            }
+        };
+
+        while (completedProcesses < n) {
+            if (readyQueue.empty()) {
+                // CPU idles until the next arrival
+                currentTime = std::max<long long>(currentTime, table.arrivalTime[arrivalOrder[nextArrival]]);
+            }
+            admitArrivals();
+
+            int index = readyQueue.pop(currentTime);
+            if (!started[index]) {
+                started[index] = true;
+                onFirstRun(index, currentTime);
+            }
+            long long runUntil = currentTime + readyQueue.timeSlice(index, remainingTime[index]);
+            if (Policy::preemptive && nextArrival < n) {
+                runUntil = std::min<long long>(runUntil, table.arrivalTime[arrivalOrder[nextArrival]]);
+            }
+            int ranFor = static_cast<int>(runUntil - currentTime);
+            remainingTime[index] -= ranFor;
+            currentTime = runUntil;
+
+            if (remainingTime[index] > 0) {
+                readyQueue.requeue(table, index, remainingTime[index], ranFor);
+            } else {
+                onComplete(index, currentTime);
+                completedProcesses++;
+            }
+        }
+    }
+
+    // Per-process waiting and turnaround times, derived in one pass over contiguous arrays
+    ScheduleResult run(const ProcessTable& table) const {
+        size_t n = table.size();
+        std::vector<long long> completionTime(n);
+        simulate(table, [](int, long long) {}, [&](int index, long long time) { completionTime[index] = time; });
+        return resultFrom(table, completionTime);
+    }
+
+    // Per-process rows and their statistics from the same simulation
+    ScheduleResult run(const ProcessTable& table, SchedulingStats& stats) const {
+        std::vector<long long> completionTime(table.size());
+        simulateWithStats(table, stats, [&](int index, long long time) { completionTime[index] = time; });
+        return resultFrom(table, completionTime);
+    }
+
+    // Streams every completion into histograms instead of keeping per-process results
+    SchedulingStats collectStats(const ProcessTable& table) const {
+        SchedulingStats stats;
+        simulateWithStats(table, stats, [](int, long long) {});
+        return stats;
+    }
+};
+
+inline void displayAverages(const ScheduleResult& result, std::ostream& out = std::cout) {
+    long long totalWaitingTime = 0;
+    long long totalTurnaroundTime = 0;
+    for (size_t i = 0; i < result.waitingTime.size(); ++i) {
+        totalWaitingTime += result.waitingTime[i];
+        totalTurnaroundTime += result.turnaroundTime[i];
+    }
+
+    // An empty table averages to 0, matching LatencyHistogram::mean
+    double n = result.waitingTime.size();
+    out << "Average Waiting Time: " << (n > 0 ? totalWaitingTime / n : 0.0) << "\n";
+    out << "Average Turnaround Time: " << (n > 0 ? totalTurnaroundTime / n : 0.0) << "\n";
+}
+
+inline void displayResults(const ProcessTable& table, const ScheduleResult& result, std::ostream& out = std::cout) {
+    out << "PID\tArrival\tBurst\tPriority\tWaiting\tTurnaround\n";
+    for (size_t i = 0; i < table.size(); ++i) {
+        out << table.id[i] << "\t"
+            << table.arrivalTime[i] << "\t"
+            << table.burstTime[i] << "\t"
+            << table.priority[i] << "\t\t"
+            << result.waitingTime[i] << "\t"
+            << result.turnaroundTime[i] << "\n";
+    }
+
+    out << "\n";
+    displayAverages(result, out);
+}
+
+inline void writeResults(const ProcessTable& table, const ScheduleResult& result, ResultWriter& writer) {
+    for (size_t i = 0; i < table.size(); ++i) {
+        writer.writeRow(table.id[i], table.arrivalTime[i], table.burstTime[i], table.priority[i],
+                        result.waitingTime[i], result.turnaroundTime[i]);
+    }
+}
+
+// Output of the single-policy programs: per-process rows, averages and tail statistics
+template <typename Policy>
+void showSchedule(const ProcessTable& table, Policy policy = Policy()) {
+    SchedulingStats stats;
+    displayResults(table, SchedulingEngine<Policy>(std::move(policy)).run(table, stats));
+    std::cout << "\n";
+    stats.display();
+}
+
+// Shared main of the single-policy programs, with argv[1] an optional workload trace and argv[2] an
+// optional result file. Without a trace the demo table is scheduled; without a result file the
+// schedule is printed. Returns the exit status.
+template <typename Policy>
+int runScheduler(int argc, char* argv[], const ProcessTable& demo, Policy policy = Policy()) {
+    try {
+        ProcessTable loaded;
+        if (argc > 1) {
+            loaded = loadProcessTable(argv[1]);
+        }
+        const ProcessTable& table = argc > 1 ? loaded : demo;
+
+        if (argc > 2) {
+            ResultWriter writer(argv[2]);
+            writeResults(table, SchedulingEngine<Policy>(std::move(policy)).run(table), writer);
+            writer.close();
+        } else {
+            showSchedule(table, std::move(policy));
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
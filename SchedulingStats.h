@@ -0,0 +1,130 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+// HDR-style log-bucketed histogram: values below 2 * SUB_BUCKETS get a bucket each and are exact;
+// above that every power of two is split into SUB_BUCKETS linear sub-buckets, so a reported
+// percentile is never more than 1 / SUB_BUCKETS (under 1%) above the true value.
+// Memory is fixed (about 57 KB) however many values are recorded.
+class LatencyHistogram {
+private:
+    static constexpr int SUB_BUCKET_BITS = 7;
+    static constexpr long long SUB_BUCKETS = 1LL << SUB_BUCKET_BITS;
+    static constexpr int BUCKET_COUNT = (64 - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+    std::vector<uint64_t> counts;
+    uint64_t totalCount;
+    long long sum;
+    long long minValue;
+    long long maxValue;
+
+    static int bucketIndex(long long value) {
+        if (value < 2 * SUB_BUCKETS) {
+            return static_cast<int>(value);
+        }
+        int highestBit = 63 - __builtin_clzll(static_cast<uint64_t>(value));
+        int shift = highestBit - SUB_BUCKET_BITS;
+        return static_cast<int>((shift + 1) * SUB_BUCKETS + ((value >> shift) - SUB_BUCKETS));
+    }
+
+    // Largest value that falls into the bucket
+    static long long bucketUpperBound(int index) {
+        if (index < 2 * SUB_BUCKETS) {
+            return index;
+        }
+        int shift = static_cast<int>(index / SUB_BUCKETS) - 1;
+        long long lower = (index % SUB_BUCKETS + SUB_BUCKETS) << shift;
+        return lower + (1LL << shift) - 1;
+    }
+
+public:
+    LatencyHistogram()
+        : counts(BUCKET_COUNT, 0), totalCount(0), sum(0),
+          minValue(std::numeric_limits<long long>::max()), maxValue(0) {}
+
+    void record(long long value) {
+        value = std::max(value, 0LL);
+        counts[bucketIndex(value)]++;
+        totalCount++;
+        sum += value;
+        minValue = std::min(minValue, value);
+        maxValue = std::max(maxValue, value);
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (int i = 0; i < BUCKET_COUNT; ++i) {
+            counts[i] += other.counts[i];
+        }
+        totalCount += other.totalCount;
+        sum += other.sum;
+        minValue = std::min(minValue, other.minValue);
+        maxValue = std::max(maxValue, other.maxValue);
+    }
+
+    uint64_t count() const { return totalCount; }
+    long long total() const { return sum; }
+    long long min() const { return totalCount ? minValue : 0; }
+    long long max() const { return maxValue; }
+    double mean() const { return totalCount ? static_cast<double>(sum) / totalCount : 0.0; }
+
+    // Smallest recorded value v such that at least fraction of all values are <= v (within bucket precision)
+    long long percentile(double fraction) const {
+        if (totalCount == 0) {
+            return 0;
+        }
+        uint64_t rank = static_cast<uint64_t>(std::ceil(fraction * totalCount));
+        rank = std::clamp<uint64_t>(rank, 1, totalCount);
+        uint64_t seen = 0;
+        for (int i = 0; i < BUCKET_COUNT; ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                return std::min(bucketUpperBound(i), maxValue);
+            }
+        }
+        return maxValue;
+    }
+};
+
+// Streaming waiting/turnaround/response statistics: each process is recorded once when it
+// completes (or first runs, for response time), so no per-process rows have to be kept.
+struct SchedulingStats {
+    LatencyHistogram waiting;
+    LatencyHistogram turnaround;
+    LatencyHistogram response;
+
+    void recordCompletion(long long waitingTime, long long turnaroundTime) {
+        waiting.record(waitingTime);
+        turnaround.record(turnaroundTime);
+    }
+
+    void recordResponse(long long responseTime) { response.record(responseTime); }
+
+    void merge(const SchedulingStats& other) {
+        waiting.merge(other.waiting);
+        turnaround.merge(other.turnaround);
+        response.merge(other.response);
+    }
+
+    void display(std::ostream& out = std::cout) const {
+        out << "Metric\t\tMean\tp50\tp90\tp99\tp99.9\tMax\n";
+        displayRow(out, "Waiting\t\t", waiting);
+        displayRow(out, "Turnaround\t", turnaround);
+        displayRow(out, "Response\t", response);
+    }
+
+private:
+    static void displayRow(std::ostream& out, const char* metric, const LatencyHistogram& histogram) {
+        out << metric
+            << histogram.mean() << "\t"
+            << histogram.percentile(0.5) << "\t"
+            << histogram.percentile(0.9) << "\t"
+            << histogram.percentile(0.99) << "\t"
+            << histogram.percentile(0.999) << "\t"
+            << histogram.max() << "\n";
+    }
+};
@@ -0,0 +1,284 @@
+#pragma once
+
+#include <cerrno>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Workload traces come in two formats:
+//   CSV:    one "id,arrival,burst[,priority]" record per line; a header line and '#' comments are skipped
+//   Binary: the 8-byte magic "SCHEDWL1", a uint64 record count, then packed int32 (id, arrival, burst, priority)
+// Results are written as CSV rows or as the magic "SCHEDRS1", then packed
+// int32 (id, arrival, burst, priority) + int64 (waiting, turnaround) records.
+
+struct JobRecord {
+    int id;
+    int arrivalTime;
+    int burstTime;
+    int priority;
+};
+
+const char WORKLOAD_MAGIC[8] = {'S', 'C', 'H', 'E', 'D', 'W', 'L', '1'};
+const char RESULT_MAGIC[8] = {'S', 'C', 'H', 'E', 'D', 'R', 'S', '1'};
+
+// Read-only memory mapping of a whole file
+class MappedFile {
+private:
+    const char* data;
+    size_t length;
+
+public:
+    MappedFile(const std::string& path) : data(nullptr), length(0) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open " + path);
+        }
+        struct stat info;
+        if (fstat(fd, &info) < 0) {
+            close(fd);
+            throw std::runtime_error("Cannot stat " + path);
+        }
+        length = info.st_size;
+        if (length > 0) {
+            void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                close(fd);
+                throw std::runtime_error("Cannot map " + path);
+            }
+            madvise(mapping, length, MADV_SEQUENTIAL);  // Records are read front to back once
+            data = static_cast<const char*>(mapping);
+        }
+        close(fd);  // The mapping stays valid after the descriptor is closed
+    }
+
+    ~MappedFile() {
+        if (data) {
+            munmap(const_cast<char*>(data), length);
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* begin() const { return data; }
+    const char* end() const { return data + length; }
+    size_t size() const { return length; }
+};
+
+// Streams job records straight out of the mapped file without copying it into memory first
+class WorkloadReader {
+private:
+    MappedFile file;
+    const char* cursor;
+    bool binary;
+    uint64_t recordCount;  // Known up front only for binary traces
+    size_t lineNumber;
+
+    bool nextBinary(JobRecord& record) {
+        if (cursor == file.end()) {
+            return false;
+        }
+        int32_t fields[4];
+        std::memcpy(fields, cursor, sizeof(fields));
+        cursor += sizeof(fields);
+        lineNumber++;  // Counts records in a binary trace
+        if (fields[1] < 0 || fields[2] < 0) {
+            throw std::runtime_error("Negative arrival or burst in workload record " + std::to_string(lineNumber));
+        }
+        record = {fields[0], fields[1], fields[2], fields[3]};
+        return true;
+    }
+
+    bool nextCSV(JobRecord& record) {
+        while (cursor < file.end()) {
+            const char* lineEnd = static_cast<const char*>(std::memchr(cursor, '\n', file.end() - cursor));
+            if (!lineEnd) {
+                lineEnd = file.end();
+            }
+            const char* line = cursor;
+            cursor = lineEnd == file.end() ? lineEnd : lineEnd + 1;
+            lineNumber++;
+
+            while (line < lineEnd && (*line == ' ' || *line == '\t')) {
+                line++;
+            }
+            // Skip blank lines, comments and a header row
+            if (line == lineEnd || *line == '\r' || !(*line == '-' || (*line >= '0' && *line <= '9'))) {
+                continue;
+            }
+
+            int fields[4] = {0, 0, 0, 0};
+            int fieldCount = 0;
+            const char* position = line;
+            while (fieldCount < 4) {
+                auto [next, error] = std::from_chars(position, lineEnd, fields[fieldCount]);
+                if (error != std::errc()) {
+                    throw std::runtime_error("Malformed workload record on line " + std::to_string(lineNumber));
+                }
+                fieldCount++;
+                while (next < lineEnd && (*next == ' ' || *next == '\t' || *next == '\r')) {
+                    next++;
+                }
+                if (next == lineEnd) {
+                    break;
+                }
+                // Anything but a separator after a number, or a fifth field, is garbage
+                if (*next != ',' || fieldCount == 4) {
+                    throw std::runtime_error("Malformed workload record on line " + std::to_string(lineNumber));
+                }
+                position = next + 1;
+                while (position < lineEnd && (*position == ' ' || *position == '\t')) {
+                    position++;
+                }
+            }
+            if (fieldCount < 3) {
+                throw std::runtime_error("Workload record on line " + std::to_string(lineNumber) + " needs id, arrival and burst");
+            }
+            if (fields[1] < 0 || fields[2] < 0) {
+                throw std::runtime_error("Negative arrival or burst on line " + std::to_string(lineNumber));
+            }
+            record = {fields[0], fields[1], fields[2], fields[3]};
+            return true;
+        }
+        return false;
+    }
+
+public:
+    WorkloadReader(const std::string& path)
+        : file(path), cursor(file.begin()), binary(false), recordCount(0), lineNumber(0) {
+        if (file.size() >= sizeof(WORKLOAD_MAGIC) && std::memcmp(file.begin(), WORKLOAD_MAGIC, sizeof(WORKLOAD_MAGIC)) == 0) {
+            binary = true;
+            if (file.size() < sizeof(WORKLOAD_MAGIC) + sizeof(recordCount)) {
+                throw std::runtime_error("Truncated workload header in " + path);
+            }
+            std::memcpy(&recordCount, file.begin() + sizeof(WORKLOAD_MAGIC), sizeof(recordCount));
+            cursor = file.begin() + sizeof(WORKLOAD_MAGIC) + sizeof(recordCount);
+            // Divide rather than multiply, so a corrupt count cannot overflow into a match
+            uint64_t payload = file.end() - cursor;
+            const uint64_t RECORD_BYTES = 4 * sizeof(int32_t);
+            if (payload % RECORD_BYTES != 0 || payload / RECORD_BYTES != recordCount) {
+                throw std::runtime_error("Workload size does not match its record count in " + path);
+            }
+        }
+    }
+
+    bool isBinary() const { return binary; }
+
+    // Exact for binary traces, zero for CSV
+    uint64_t expectedRecords() const { return recordCount; }
+
+    bool next(JobRecord& record) {
+        return binary ? nextBinary(record) : nextCSV(record);
+    }
+};
+
+inline bool hasBinaryExtension(const std::string& path) {
+    return path.size() >= 4 && path.compare(path.size() - 4, 4, ".bin") == 0;
+}
+
+// Buffered result sink: rows are formatted into a fixed buffer and written out in large blocks,
+// so memory stays bounded no matter how many rows pass through
+class ResultWriter {
+private:
+    int fd;
+    bool binary;
+    std::vector<char> buffer;
+    size_t used;
+
+    void writeAll(const char* bytes, size_t count) {
+        size_t written = 0;
+        while (written < count) {
+            ssize_t result = write(fd, bytes + written, count - written);
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;  // Interrupted before anything was written
+                }
+                throw std::runtime_error("Failed to write results");
+            }
+            written += result;
+        }
+    }
+
+    void append(const void* bytes, size_t count) {
+        if (used + count > buffer.size()) {
+            flush();
+            if (count > buffer.size()) {
+                writeAll(static_cast<const char*>(bytes), count);  // Buffer smaller than one row: write through
+                return;
+            }
+        }
+        std::memcpy(buffer.data() + used, bytes, count);
+        used += count;
+    }
+
+    void appendNumber(long long value, char separator) {
+        char text[24];
+        char* end = std::to_chars(text, text + sizeof(text) - 1, value).ptr;
+        *end++ = separator;
+        append(text, end - text);
+    }
+
+public:
+    // Binary output is chosen by a ".bin" extension, anything else is written as CSV
+    ResultWriter(const std::string& path, size_t bufferSize = 1 << 20)
+        : fd(-1), binary(hasBinaryExtension(path)), buffer(bufferSize), used(0) {
+        fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot create " + path);
+        }
+        if (binary) {
+            append(RESULT_MAGIC, sizeof(RESULT_MAGIC));
+        } else {
+            const char header[] = "id,arrival,burst,priority,waiting,turnaround\n";
+            append(header, sizeof(header) - 1);
+        }
+    }
+
+    ~ResultWriter() {
+        if (fd >= 0) {
+            try {
+                close();
+            } catch (const std::exception&) {
+                // Destructors must not throw; call close() to see write errors
+            }
+        }
+    }
+
+    ResultWriter(const ResultWriter&) = delete;
+    ResultWriter& operator=(const ResultWriter&) = delete;
+
+    void writeRow(int id, int arrivalTime, int burstTime, int priority, long long waitingTime, long long turnaroundTime) {
+        if (binary) {
+            int32_t jobFields[4] = {id, arrivalTime, burstTime, priority};
+            int64_t timeFields[2] = {waitingTime, turnaroundTime};
+            append(jobFields, sizeof(jobFields));
+            append(timeFields, sizeof(timeFields));
+        } else {
+            appendNumber(id, ',');
+            appendNumber(arrivalTime, ',');
+            appendNumber(burstTime, ',');
+            appendNumber(priority, ',');
+            appendNumber(waitingTime, ',');
+            appendNumber(turnaroundTime, '\n');
+        }
+    }
+
+    void flush() {
+        writeAll(buffer.data(), used);
+        used = 0;
+    }
+
+    void close() {
+        flush();
+        ::close(fd);
+        fd = -1;
+    }
+};